@@ -0,0 +1,387 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ArenaStringList Implementation
+ *
+ * Description:
+ * This file implements a singly linked list of strings whose nodes hold
+ * interned views into the pool's StringArena instead of string objects.
+ */
+
+#include "ArenaStringList.h"
+#include <iostream>
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Initialize an empty list with a given external node pool.
+   Input: externalPool (pointer to ArenaNodePool)
+   Output: A new empty list
+   ----------------------------- */
+ArenaStringList::ArenaStringList(ArenaNodePool* externalPool)
+{
+    pool = externalPool;       // Node pool used for nodes and characters
+    head = NULL_INDEX;         // Head index starts as null
+    tail = NULL_INDEX;         // Tail index starts as null
+    mySize = 0;                // Start with empty list
+}
+
+/* -----------------------------
+   Destructor
+   Purpose: Release all nodes back to the pool.
+   Input: None
+   Output: Frees all nodes
+   ----------------------------- */
+ArenaStringList::~ArenaStringList()
+{
+    clear();
+}
+
+/* -----------------------------
+   empty()
+   Purpose: Check if the list is empty.
+   Input: None
+   Output: true if empty, false otherwise
+   ----------------------------- */
+bool ArenaStringList::empty() const
+{
+    return head == NULL_INDEX;
+}
+
+/* -----------------------------
+   length()
+   Purpose: Return the number of elements in the list.
+   Input: None
+   Output: Count of nodes in the list
+   ----------------------------- */
+int ArenaStringList::length() const
+{
+    return mySize;
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Return the whole chain of nodes to the pool at once.
+   Input: None
+   Output: List becomes empty
+   ----------------------------- */
+void ArenaStringList::clear()
+{
+    if (head != NULL_INDEX) {
+        pool->releaseChain(head, tail, mySize);
+    }
+    head = NULL_INDEX;
+    tail = NULL_INDEX;
+    mySize = 0;
+}
+
+/* -----------------------------
+   acquire()
+   Purpose: Take a node and store the interned view of a value in it.
+   Input: value (string_view)
+   Output: Node index, or NULL_INDEX if the pool or arena is full
+   ----------------------------- */
+int ArenaStringList::acquire(string_view value)
+{
+    int node = pool->acquireNode();
+    if (node == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return NULL_INDEX;
+    }
+
+    ArenaString stored = pool->arena().intern(value); // No allocation for repeats
+    if (stored.length != value.size()) {
+        pool->releaseNode(node); // Arena full, error already printed
+        return NULL_INDEX;
+    }
+    pool->data(node) = stored;
+    pool->next(node) = NULL_INDEX;
+    return node;
+}
+
+/* -----------------------------
+   insert()
+   Purpose: Insert a value at a given position.
+   Input: value (string_view), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArenaStringList::insert(string_view value, int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    if (position == mySize) {
+        return push_back(value);
+    }
+
+    int node = acquire(value);
+    if (node == NULL_INDEX) {
+        return false;
+    }
+
+    if (position == 0) {
+        pool->next(node) = head;
+        head = node;
+    }
+    else {
+        int previous = head;
+        for (int i = 1; i < position; i++) {
+            previous = pool->next(previous);
+        }
+        pool->next(node) = pool->next(previous);
+        pool->next(previous) = node;
+    }
+    mySize++;
+    return true;
+}
+
+/* -----------------------------
+   remove()
+   Purpose: Remove the value at a given position.
+   Input: position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArenaStringList::remove(int position)
+{
+    if (position < 0 || position >= mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+
+    int previous = NULL_INDEX;
+    int current = head;
+    for (int i = 0; i < position; i++) {
+        previous = current;
+        current = pool->next(current);
+    }
+
+    if (previous == NULL_INDEX) {
+        head = pool->next(current);
+    }
+    else {
+        pool->next(previous) = pool->next(current);
+    }
+    if (current == tail) {
+        tail = previous;
+    }
+    pool->releaseNode(current); // Characters stay in the arena
+    mySize--;
+    return true;
+}
+
+/* -----------------------------
+   push_back()
+   Purpose: Append a value using the tail index.
+   Input: value (string_view)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArenaStringList::push_back(string_view value)
+{
+    int node = acquire(value);
+    if (node == NULL_INDEX) {
+        return false;
+    }
+    if (tail == NULL_INDEX) {
+        head = node;
+    }
+    else {
+        pool->next(tail) = node;
+    }
+    tail = node;
+    mySize++;
+    return true;
+}
+
+/* -----------------------------
+   push_front() / pop_front()
+   Purpose: Insert or remove at the front.
+   Input: value (string_view) for push_front
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArenaStringList::push_front(string_view value)
+{
+    return insert(value, 0);
+}
+
+bool ArenaStringList::pop_front()
+{
+    if (head == NULL_INDEX) {
+        cerr << "Error: List is empty" << endl;
+        return false;
+    }
+    return remove(0);
+}
+
+/* -----------------------------
+   search()
+   Purpose: Find the position of a value by its interned view.
+   Input: value (string_view)
+   Output: Position if found, -1 otherwise
+   ----------------------------- */
+int ArenaStringList::search(string_view value) const
+{
+    ArenaString key;
+    if (!pool->arena().lookup(value, key)) {
+        return -1; // Never interned: no node can hold it
+    }
+    if (pool->length() == size_t(mySize)) {
+        return int(pool->findInChain(head, key)); // 8-byte payload scan
+    }
+
+    // Other lists share the pool: their views would only be false matches
+    int position = 0;
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        if (pool->data(current) == key) {
+            return position;
+        }
+        position++;
+    }
+    return -1;
+}
+
+/* -----------------------------
+   display()
+   Purpose: Print all elements in the list.
+   Input: None
+   Output: Elements printed in order
+   ----------------------------- */
+void ArenaStringList::display() const
+{
+    cout << "List: ";
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        cout << pool->arena().view(pool->data(current)) << " ";
+    }
+    cout << endl;
+}
+
+/* -----------------------------
+   begin() / end()
+   Purpose: Iterators over the elements in list order.
+   Input: None
+   Output: First element / one past the last
+   ----------------------------- */
+ArenaStringList::const_iterator ArenaStringList::begin() const
+{
+    return const_iterator(this, head);
+}
+
+ArenaStringList::const_iterator ArenaStringList::end() const
+{
+    return const_iterator(this, NULL_INDEX);
+}
+
+ArenaStringList::const_iterator ArenaStringList::cbegin() const
+{
+    return begin();
+}
+
+ArenaStringList::const_iterator ArenaStringList::cend() const
+{
+    return end();
+}
+
+/* -----------------------------
+   Copy Constructor
+   Purpose: Create a copy of another list on the same pool.
+   Input: source (ArenaStringList)
+   Output: A new list identical to source
+   ----------------------------- */
+ArenaStringList::ArenaStringList(const ArenaStringList& source)
+{
+    pool = source.pool;
+    head = NULL_INDEX;
+    tail = NULL_INDEX;
+    mySize = 0;
+    copyNodes(source);
+}
+
+/* -----------------------------
+   operator=
+   Purpose: Replace the contents with source's values.
+   Input: source (ArenaStringList)
+   Output: *this updated to match source
+   ----------------------------- */
+ArenaStringList& ArenaStringList::operator=(const ArenaStringList& source)
+{
+    if (this != &source) {
+        clear(); // Current nodes go back as one chain
+        copyNodes(source);
+    }
+    return *this;
+}
+
+/* -----------------------------
+   Move Constructor
+   Purpose: Take over another list's nodes in O(1).
+   Input: source (ArenaStringList rvalue)
+   Output: A list holding source's elements; source is empty
+   ----------------------------- */
+ArenaStringList::ArenaStringList(ArenaStringList&& source) noexcept
+{
+    pool = source.pool;
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+}
+
+/* -----------------------------
+   operator= (move)
+   Purpose: Release the current nodes and take over source's.
+   Input: source (ArenaStringList rvalue)
+   Output: *this holds source's elements; source is empty
+   ----------------------------- */
+ArenaStringList& ArenaStringList::operator=(ArenaStringList&& source)
+{
+    if (this == &source) {
+        return *this;
+    }
+    if (pool != source.pool) {
+        return *this = static_cast<const ArenaStringList&>(source); // Views belong to one arena
+    }
+
+    clear();
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+    return *this;
+}
+
+/* -----------------------------
+   copyNodes()
+   Purpose: Copy source's values into one freshly acquired chain.
+   Input: source (ArenaStringList)
+   Output: The empty list now equals source
+   ----------------------------- */
+void ArenaStringList::copyNodes(const ArenaStringList& source)
+{
+    if (source.head == NULL_INDEX) {
+        return;
+    }
+    int last;
+    int first = pool->acquireNodes(source.mySize, last);
+    if (first == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return;
+    }
+
+    // Within one pool the views are shared; another pool interns the values
+    bool samePool = (pool == source.pool);
+    int from = source.head;
+    for (int current = first; current != NULL_INDEX; current = pool->next(current)) {
+        ArenaString value = source.pool->data(from);
+        pool->data(current) = samePool ? value
+                                        : pool->arena().intern(source.pool->arena().view(value));
+        from = source.pool->next(from);
+    }
+    head = first;
+    tail = last;
+    mySize = source.mySize;
+}
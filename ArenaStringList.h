@@ -0,0 +1,266 @@
+/*-- ArenaStringList.h -----------------------------------------------------
+
+  This header file defines the class ArenaStringList, a singly linked list
+  of strings on an ArenaNodePool. A node does not hold a string object:
+  its payload is an 8-byte ArenaString view of characters kept in the
+  pool's StringArena (see StringArena.h). Values are interned, so a value
+  that is already in the arena costs no bytes at all and a new one is
+  copied to the end of the arena; inserting never calls malloc except
+  when the arena or the pool grows.
+
+  Basic operations are the positional ones of ArrayBasedList:
+    Constructor
+    Destructor
+    empty:Check if list is empty
+    insert:Insert a value at a position
+    remove:Delete the value at a position
+    push_back:Append a value in O(1) using the tail
+    push_front:Prepend a value
+    pop_front:Remove the first value
+    search:Find the position of a value
+    display:Output the list
+    begin/end:Forward iterators yielding string_view
+
+  Because equal values share one view, search() compares views instead of
+  characters. A value never interned on the pool is answered without a
+  walk. Views stay interned until ArenaNodePool::clear(), so a value that
+  was removed, or that another list holds, still takes a search: while
+  the list holds every node in use NodePool::findInChain scans the
+  payload arrays for the view's 8 bytes (see PayloadScan.h), and
+  otherwise the list is walked comparing views.
+
+  Removing a value only unlinks its node; the characters stay in the
+  arena, which is shared by every list on the pool and is emptied all at
+  once by ArenaNodePool::clear(). After that clear() the lists on the pool
+  must not be used again except to be cleared or destroyed. Copies on the
+  same pool share the characters and only copy views; a copy onto
+  another pool interns the values there.
+
+-------------------------------------------------------------------------*/
+
+#ifndef ARENASTRINGLIST_H
+#define ARENASTRINGLIST_H
+#include <string>
+#include <string_view>
+#include "nodepool.h"
+#include "StringArena.h"
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+
+typedef BasicNodePool<ArenaString, int, SplitLayout> ArenaNodePool;
+
+class ArenaStringList
+{
+public:
+    /*** const_iterator: forward iterator over the values of a list ***/
+    class const_iterator
+    {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef string_view value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const string_view* pointer;
+        typedef string_view reference; // Views are returned by value
+
+        const_iterator() : list(0), node(NULL_INDEX) {}
+        const_iterator(const ArenaStringList* owner, int at) : list(owner), node(at) {}
+
+        string_view operator*() const { return list->pool->arena().view(list->pool->data(node)); }
+
+        const_iterator& operator++()
+        {
+            node = list->pool->next(node);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            node = list->pool->next(node);
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+
+    private:
+        const ArenaStringList* list; // List iterated over
+        int node;                    // Current node, NULL_INDEX at end()
+    };
+
+    typedef const_iterator iterator; // Values are changed through the list only
+
+    /******** Function Members ********/
+
+    ArenaStringList(ArenaNodePool* externalPool);
+    /*----------------------------------------------------------------------
+      Construct an ArenaStringList using an external ArenaNodePool.
+
+      Precondition:  externalPool points to a valid ArenaNodePool object.
+      Postcondition: An empty list is created with no nodes.
+    -----------------------------------------------------------------------*/
+
+    ~ArenaStringList();
+    /*----------------------------------------------------------------------
+     Destroy the list and return all nodes to the free list.
+
+     Precondition:  None
+     Postcondition: All nodes of the list are released to the pool; their
+                    characters stay in the arena.
+    -----------------------------------------------------------------------*/
+
+    bool empty() const;
+    /*----------------------------------------------------------------------
+     Check if the list is empty.
+
+     Precondition:  None
+     Postcondition: Returns true if list is empty, false otherwise.
+    -----------------------------------------------------------------------*/
+
+    bool insert(string_view value, int position);
+    /*----------------------------------------------------------------------
+     Insert a value at a given position.
+
+     Precondition:  0 <= position <= current list length; node pool has
+                    space or can grow.
+     Postcondition: value is interned and its view inserted at position.
+    -----------------------------------------------------------------------*/
+
+    bool remove(int position);
+    /*----------------------------------------------------------------------
+     Remove the value at a given position.
+
+     Precondition:  0 <= position < current list length.
+     Postcondition: The node is returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool push_back(string_view value);
+    /*----------------------------------------------------------------------
+     Append a value at the end of the list in O(1).
+
+     Precondition:  node pool has space or can grow.
+     Postcondition: value is the last element.
+    -----------------------------------------------------------------------*/
+
+    bool push_front(string_view value);
+    /*----------------------------------------------------------------------
+     Insert a value at the front of the list; same as insert(value, 0).
+    -----------------------------------------------------------------------*/
+
+    bool pop_front();
+    /*----------------------------------------------------------------------
+     Remove the first value of the list; same as remove(0).
+
+     Precondition:  List is not empty.
+    -----------------------------------------------------------------------*/
+
+    int search(string_view value) const;
+    /*----------------------------------------------------------------------
+     Search for a value in the list.
+
+     Precondition:  None
+     Postcondition: Returns position of value if found, -1 otherwise.
+    -----------------------------------------------------------------------*/
+
+    void display() const;
+    /*----------------------------------------------------------------------
+     Display the contents of the list.
+
+     Precondition:  None
+     Postcondition: Outputs list elements in order to standard output.
+    -----------------------------------------------------------------------*/
+
+    int length() const;
+    /*----------------------------------------------------------------------
+      Return the number of elements in the list.
+
+      Precondition:  None
+      Postcondition: Returns the count of nodes in the list.
+    -----------------------------------------------------------------------*/
+
+    void clear();
+    /*----------------------------------------------------------------------
+      Clear the list and return all nodes to the pool.
+
+      Precondition:  None
+      Postcondition: List is empty; the arena is left as it is.
+    -----------------------------------------------------------------------*/
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    /*----------------------------------------------------------------------
+      Iterators over the values in list order. A view is valid until the
+      arena next grows.
+
+      Precondition:  None
+      Postcondition: begin() == end() for an empty list.
+    -----------------------------------------------------------------------*/
+
+    /***** Copy constructor *****/
+    ArenaStringList(const ArenaStringList&);
+    /*----------------------------------------------------------------------
+     Copy constructor.
+
+     Precondition:  None
+     Postcondition: A new list on source's pool holds the same views
+                    (empty, with an error, if the pool is full).
+    -----------------------------------------------------------------------*/
+
+    ArenaStringList& operator=(const ArenaStringList&);
+    /*----------------------------------------------------------------------
+     Assignment operator.
+
+     Precondition:  None
+     Postcondition: The current list is cleared and replaced with source's
+                    values, interned in this list's pool if it differs.
+    -----------------------------------------------------------------------*/
+
+    /***** Move constructor *****/
+    ArenaStringList(ArenaStringList&& source) noexcept;
+    /*----------------------------------------------------------------------
+     Move constructor; O(1).
+
+     Precondition:  None
+     Postcondition: The new list holds source's nodes; source is empty.
+    -----------------------------------------------------------------------*/
+
+    ArenaStringList& operator=(ArenaStringList&& source);
+    /*----------------------------------------------------------------------
+     Move assignment.
+
+     Precondition:  None
+     Postcondition: The current nodes are released and source's taken
+                    over in O(1), leaving source empty. Lists on
+                    different pools cannot trade nodes: then this copies.
+    -----------------------------------------------------------------------*/
+
+private:
+    int acquire(string_view value);
+    /*----------------------------------------------------------------------
+      Take a node from the pool holding the interned view of value.
+
+      Precondition:  None
+      Postcondition: Returns the node, or NULL_INDEX (with an error) if
+                     the pool is exhausted.
+    -----------------------------------------------------------------------*/
+
+    void copyNodes(const ArenaStringList& source);
+    /*----------------------------------------------------------------------
+      Fill an empty list with source's values.
+
+      Precondition:  The list is empty.
+      Postcondition: The list equals source (empty on pool exhaustion).
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+
+    int head; // Index of first node in the list
+    int tail; // Index of last node in the list
+    ArenaNodePool* pool; // Pointer to external node pool
+    int mySize; // Number of nodes
+};
+
+#endif
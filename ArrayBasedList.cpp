@@ -11,166 +11,1790 @@
  */
 
 #include "ArrayBasedList.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
 using namespace std;
 
+typedef PayloadCodec<ElementType> Codec;
+
+// Binary stream format (see exportTo in ArrayBasedList.h)
+static const char STREAM_MAGIC[4] = { 'A', 'B', 'L', 'S' };
+static const unsigned int STREAM_VERSION = 1;
+static const size_t STREAM_HEADER = 24; // magic, version, count, bytes
+
+/*** RelayoutPass: state of an incremental relayout between calls ***/
+struct ArrayBasedList::RelayoutPass
+{
+    vector<int> at;       // at[k]: node now holding position k
+    unordered_map<int, int> occupant; // Position held by each node of ours
+    int walk;             // Next node to collect, NULL_INDEX once collected
+    size_t placed;        // Positions already in their final node
+    size_t slot;          // Next node index to hand to a position
+};
+
+/* -----------------------------
+   sendAll()
+   Purpose: write() a whole buffer, retrying short and interrupted writes.
+   Input: fd (int), data, length (size_t)
+   Output: true if every byte was written
+   ----------------------------- */
+static bool sendAll(int fd, const char* data, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= size_t(written);
+    }
+    return true;
+}
+
+/* -----------------------------
+   receiveAll()
+   Purpose: read() until length bytes arrived or the data ends.
+   Input: fd (int), data, length (size_t)
+   Output: true if all length bytes were read
+   ----------------------------- */
+static bool receiveAll(int fd, char* data, size_t length)
+{
+    while (length > 0) {
+        ssize_t got = read(fd, data, length);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return false;
+        }
+        data += got;
+        length -= size_t(got);
+    }
+    return true;
+}
+
+/* -----------------------------
+   writeStreamHeader()
+   Purpose: Encode the stream header.
+   Input: out (STREAM_HEADER bytes), count and bytes (size_t)
+   Output: Header written to out
+   ----------------------------- */
+static void writeStreamHeader(char* out, size_t count, size_t bytes)
+{
+    unsigned long long count64 = count, bytes64 = bytes;
+    memcpy(out, STREAM_MAGIC, 4);
+    memcpy(out + 4, &STREAM_VERSION, 4);
+    memcpy(out + 8, &count64, 8);
+    memcpy(out + 16, &bytes64, 8);
+}
+
+/* -----------------------------
+   fillBlock()
+   Purpose: Make sure block holds need unread bytes of the stream, reading
+            as much more of the list as fits (but never past its end).
+   Input: fd (int), block, pos/held (unread range), remaining (bytes of the
+          list not read yet), need (size_t)
+   Output: true if block[pos..held) now has at least need bytes
+   ----------------------------- */
+static bool fillBlock(int fd, vector<char>& block, size_t& pos, size_t& held,
+                      size_t& remaining, size_t need)
+{
+    if (need > held - pos + remaining) {
+        return false; // The list ends before this record does
+    }
+    memmove(block.data(), block.data() + pos, held - pos);
+    held -= pos;
+    pos = 0;
+    if (need > block.size()) {
+        block.resize(need); // One record larger than a block
+    }
+    size_t wanted = min(block.size() - held, remaining);
+    if (!receiveAll(fd, block.data() + held, wanted)) {
+        return false;
+    }
+    held += wanted;
+    remaining -= wanted;
+    return true;
+}
+
 /* -----------------------------
    Constructor
    Purpose: Initialize an empty list with a given external node pool.
    Input: externalPool (pointer to NodePool)
    Output: A new empty list
    ----------------------------- */
-ArrayBasedList::ArrayBasedList(NodePool* externalPool)
+ArrayBasedList::ArrayBasedList(NodePool* externalPool)
+{
+    pool = externalPool;       // Node pool used for memory management
+    head = NULL_INDEX;         // Head index starts as null
+    tail = NULL_INDEX;         // Tail index starts as null
+    mySize = 0;                // Start with empty list
+    fingerPos = -1;            // No position resolved yet
+    fingerIndex = NULL_INDEX;
+    index = 0;                 // No position index unless enabled
+    values = 0;                // No value index unless enabled
+    rootSlot = -1;             // Not kept in a pool root
+    relayoutPass = 0;          // No incremental relayout running
+    sharedTail = 0;            // No node shared with another list
+    handlesOut = false;        // No handle issued
+    epochs = 0;                // No concurrent readers
+    STATS_ONLY(stepsTaken = 0;)
+}
+
+/* -----------------------------
+   Destructor
+   Purpose: Release all nodes back to the pool.
+   Input: None
+   Output: Frees all nodes, resets list to empty
+   ----------------------------- */
+ArrayBasedList::~ArrayBasedList()
+{
+    if (rootSlot != -1) {
+        saveRoot(rootSlot); // The nodes stay in the pool under the root
+    }
+    else {
+        releaseAll(); // One splice onto the free list
+    }
+    delete index;
+    delete values;
+    delete relayoutPass;
+    delete epochs; // Retired nodes go back to the pool
+}
+
+/* -----------------------------
+   empty()
+   Purpose: Check if the list is empty.
+   Input: None
+   Output: true if empty, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::empty() const {
+    return head == NULL_INDEX;
+}
+
+/* -----------------------------
+   length()
+   Purpose: Return the number of active elements in the list.
+   Input: None
+   Output: Count of nodes in the list
+   ----------------------------- */
+int ArrayBasedList::length() const
+{
+    return mySize;
+}
+
+
+/* -----------------------------
+   clear()
+   Purpose: Remove all nodes from the list and return them to the pool.
+   Input: None
+   Output: List becomes empty and all nodes are released
+   ----------------------------- */
+void ArrayBasedList::clear()
+{
+    releaseAll();
+    if (index != 0) {
+        index->clear();
+    }
+    if (values != 0) {
+        values->clear();
+    }
+}
+
+/* -----------------------------
+   releaseAll()
+   Purpose: Return the whole chain of nodes to the pool at once.
+   Input: None
+   Output: List is empty; indexes untouched
+   ----------------------------- */
+void ArrayBasedList::releaseAll()
+{
+    cancelRelayout();
+    if (epochs != 0) {
+        // Readers may be on any node: unpublish the chain, then retire it
+        int current = head;
+        publishHead(NULL_INDEX);
+        while (current != NULL_INDEX) {
+            int following = pool->next(current);
+            pool->retire(current); // Handles go stale now, not after the grace period
+            epochs->retire(current);
+            current = following;
+        }
+    }
+    else if (head != NULL_INDEX && sharedTail == 0) {
+        pool->releaseChain(head, tail, mySize);
+    }
+    else if (head != NULL_INDEX) {
+        // Release up to the first node another list still refers to
+        int last = NULL_INDEX;
+        size_t count = 0;
+        for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+            if (pool->dropReference(current)) {
+                break;
+            }
+            last = current;
+            count++;
+        }
+        pool->releaseChain(head, last, count);
+    }
+    sharedTail = 0;
+    publishHead(NULL_INDEX);
+    tail = NULL_INDEX;
+    mySize = 0;
+    fingerPos = -1;
+}
+
+/* -----------------------------
+   rebuildIndexes()
+   Purpose: Rebuild the kept indexes from the current nodes.
+   Input: None
+   Output: PositionIndex / ValueIndex match the list
+   ----------------------------- */
+void ArrayBasedList::rebuildIndexes()
+{
+    if (index != 0) {
+        index->build(head, mySize);
+    }
+    if (values != 0) {
+        enableValueIndex(); // Re-inserts every node
+    }
+}
+
+/* -----------------------------
+   saveRoot()
+   Purpose: Record the list in a root slot of the pool.
+   Input: slot (int)
+   Output: true if recorded
+   ----------------------------- */
+bool ArrayBasedList::saveRoot(int slot)
+{
+    // Reference counts are not saved: a rooted list owns all its nodes
+    if (!privatize(mySize)) {
+        return false;
+    }
+    if (!pool->setRoot(slot, head, tail, size_t(mySize))) {
+        return false;
+    }
+    rootSlot = slot;
+    return true;
+}
+
+/* -----------------------------
+   loadRoot()
+   Purpose: Take over the chain recorded in a root slot.
+   Input: slot (int)
+   Output: true if the list now holds the recorded chain
+   ----------------------------- */
+bool ArrayBasedList::loadRoot(int slot)
+{
+    if (!empty()) {
+        cerr << "Error: List must be empty to load a root" << endl;
+        return false;
+    }
+
+    int rootHead, rootTail;
+    size_t count;
+    if (!pool->getRoot(slot, rootHead, rootTail, count)) {
+        return false;
+    }
+    bool fits = (count == 0) ? (rootHead == NULL_INDEX)
+                             : (count <= pool->capacity() && rootHead >= 0 && rootTail >= 0 &&
+                                size_t(rootHead) < pool->capacity() &&
+                                size_t(rootTail) < pool->capacity());
+    if (!fits) {
+        cerr << "Error: Root " << slot << " does not describe a list in this pool" << endl;
+        return false;
+    }
+
+    cancelRelayout();
+    publishHead(rootHead);
+    tail = rootTail;
+    mySize = int(count);
+    sharedTail = 0;
+    fingerPos = -1;
+    rootSlot = slot;
+    rebuildIndexes();
+    return true;
+}
+
+/* -----------------------------
+   stats()
+   Purpose: Snapshot of the step histograms.
+   Input: None
+   Output: ListStats
+   ----------------------------- */
+ListStats ArrayBasedList::stats() const
+{
+    ListStats result = {};
+#ifdef NODEPOOL_STATS
+    insertSteps.snapshot(result.insert);
+    removeSteps.snapshot(result.remove);
+    searchSteps.snapshot(result.search);
+#endif
+    return result;
+}
+
+/* -----------------------------
+   resetStats()
+   Purpose: Clear the step histograms.
+   Input: None
+   Output: Every bucket is 0
+   ----------------------------- */
+void ArrayBasedList::resetStats()
+{
+#ifdef NODEPOOL_STATS
+    insertSteps.reset();
+    removeSteps.reset();
+    searchSteps.reset();
+#endif
+}
+
+/* -----------------------------
+   getHead()
+   Purpose: Retrieve the index of the head node.
+   Input: None
+   Output: Index of the first node in the list
+   ----------------------------- */
+int ArrayBasedList::getHead() const
+{
+    return head;
+}
+
+/* -----------------------------
+   begin() / end()
+   Purpose: Iterators over the elements.
+   Input: None
+   Output: Iterator at the head, or past the tail; the mutable begin()
+           is end() if shared nodes could not be copied
+   ----------------------------- */
+ArrayBasedList::iterator ArrayBasedList::begin()
+{
+    if (!privatize(mySize)) {
+        return end(); // Writing through it would change other lists
+    }
+    return iterator(this, head);
+}
+
+ArrayBasedList::iterator ArrayBasedList::end()
+{
+    return iterator(this, NULL_INDEX);
+}
+
+ArrayBasedList::const_iterator ArrayBasedList::begin() const
+{
+    return const_iterator(this, loadHead());
+}
+
+ArrayBasedList::const_iterator ArrayBasedList::end() const
+{
+    return const_iterator(this, NULL_INDEX);
+}
+
+ArrayBasedList::const_iterator ArrayBasedList::cbegin() const
+{
+    return const_iterator(this, loadHead());
+}
+
+ArrayBasedList::const_iterator ArrayBasedList::cend() const
+{
+    return const_iterator(this, NULL_INDEX);
+}
+
+/* -----------------------------
+   before_begin()
+   Purpose: Iterator in front of the head, for insert_after/erase_after.
+   Input: None
+   Output: Iterator whose increment is begin(); the mutable one is
+           end() if shared nodes could not be copied
+   ----------------------------- */
+ArrayBasedList::iterator ArrayBasedList::before_begin()
+{
+    if (!privatize(mySize)) {
+        return end();
+    }
+    return iterator(this, BEFORE_HEAD);
+}
+
+ArrayBasedList::const_iterator ArrayBasedList::before_begin() const
+{
+    return const_iterator(this, BEFORE_HEAD);
+}
+
+/* -----------------------------
+   insert_after()
+   Purpose: Insert a value after an iterator without resolving positions.
+   Input: position (const_iterator), value (ElementType)
+   Output: Iterator to the new element, end() on failure
+   ----------------------------- */
+ArrayBasedList::iterator ArrayBasedList::insert_after(const_iterator position, const ElementType& value)
+{
+    int prev = position.node;
+    if (prev == NULL_INDEX) {
+        cerr << "Error: Cannot insert after end()" << endl;
+        return end();
+    }
+    if (!privatize(mySize, prev)) {
+        return end();
+    }
+    int newIndex = pool->acquireNode();
+    if (newIndex == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return end();
+    }
+
+    cancelRelayout();
+    pool->data(newIndex) = value;
+    if (values != 0) {
+        values->insert(newIndex);
+    }
+
+    int rank = 0;
+    if (prev == BEFORE_HEAD) {
+        pool->next(newIndex) = head;
+        publishHead(newIndex);
+    }
+    else {
+        if (index != 0) {
+            rank = index->rankOf(prev) + 1;
+        }
+        pool->next(newIndex) = pool->next(prev);
+        pool->publishNext(prev, newIndex);
+    }
+    if (pool->next(newIndex) == NULL_INDEX) {
+        tail = newIndex;
+    }
+
+    mySize++;
+    if (index != 0) {
+        index->inserted(rank, newIndex);
+    }
+    fingerPos = -1; // Its position is not known here
+    return iterator(this, newIndex);
+}
+
+/* -----------------------------
+   erase_after()
+   Purpose: Remove the element after an iterator.
+   Input: position (const_iterator)
+   Output: Iterator to the element after the removed one
+   ----------------------------- */
+ArrayBasedList::iterator ArrayBasedList::erase_after(const_iterator position)
+{
+    int prev = position.node;
+    if (prev == NULL_INDEX) {
+        cerr << "Error: Nothing to erase" << endl;
+        return end();
+    }
+    if (!privatize(mySize, prev)) {
+        return end();
+    }
+    int toRemove = (prev == BEFORE_HEAD) ? head : pool->next(prev);
+    if (toRemove == NULL_INDEX) {
+        cerr << "Error: Nothing to erase" << endl;
+        return end();
+    }
+
+    cancelRelayout();
+    if (index != 0) {
+        index->removed(index->rankOf(toRemove));
+    }
+    if (values != 0) {
+        values->erase(toRemove);
+    }
+
+    int following = pool->next(toRemove);
+    if (prev == BEFORE_HEAD) {
+        publishHead(following);
+    }
+    else {
+        pool->publishNext(prev, following);
+    }
+    if (toRemove == tail) {
+        tail = (prev == BEFORE_HEAD) ? NULL_INDEX : prev;
+    }
+
+    releaseRemoved(toRemove);
+    mySize--;
+    fingerPos = -1;
+    return iterator(this, following);
+}
+
+/* -----------------------------
+   issueHandle()
+   Purpose: Make a handle to a node of the list.
+   Input: node (int)
+   Output: Handle stamped by the pool
+   ----------------------------- */
+NodeHandle ArrayBasedList::issueHandle(int node)
+{
+    handlesOut = true; // From now on copies do not share our chain
+    return pool->handleOf(node);
+}
+
+/* -----------------------------
+   insertHandle()
+   Purpose: Insert a value at a position and return its handle.
+   Input: value (ElementType), position (int)
+   Output: Handle of the new element, null on failure
+   ----------------------------- */
+NodeHandle ArrayBasedList::insertHandle(const ElementType& value, int position)
+{
+    if (!privatize(mySize) || !insert(value, position)) {
+        return NodeHandle();
+    }
+    return issueHandle(fingerIndex); // The finger rests on the new node
+}
+
+/* -----------------------------
+   searchHandle()
+   Purpose: Find the first element equal to value.
+   Input: value (ElementType)
+   Output: Its handle, null if not found
+   ----------------------------- */
+NodeHandle ArrayBasedList::searchHandle(const ElementType& value)
+{
+    if (!privatize(mySize)) {
+        return NodeHandle();
+    }
+    int position = search(value);
+    if (position < 0) {
+        return NodeHandle();
+    }
+    return issueHandle(nodeAt(position));
+}
+
+/* -----------------------------
+   insertAfter()
+   Purpose: Insert a value after a handle's element in O(1).
+   Input: handle (NodeHandle, null for the front), value (ElementType)
+   Output: Handle of the new element, null on failure
+   ----------------------------- */
+NodeHandle ArrayBasedList::insertAfter(NodeHandle handle, const ElementType& value)
+{
+    if (!handle.isNull() && !pool->isValid(handle)) {
+        cerr << "Error: Stale node handle" << endl;
+        return NodeHandle();
+    }
+    int prev = handle.isNull() ? int(BEFORE_HEAD) : handle.index;
+    iterator added = insert_after(const_iterator(this, prev), value);
+    if (added == end()) {
+        return NodeHandle();
+    }
+    return issueHandle(added.node);
+}
+
+/* -----------------------------
+   removeAfter()
+   Purpose: Remove the element after a handle's element in O(1).
+   Input: handle (NodeHandle, null for the front)
+   Output: true if an element was removed
+   ----------------------------- */
+bool ArrayBasedList::removeAfter(NodeHandle handle)
+{
+    if (!handle.isNull() && !pool->isValid(handle)) {
+        cerr << "Error: Stale node handle" << endl;
+        return false;
+    }
+    int before = mySize;
+    erase_after(const_iterator(this, handle.isNull() ? int(BEFORE_HEAD) : handle.index));
+    return mySize < before;
+}
+
+/* -----------------------------
+   get()
+   Purpose: Access the value of a handle's element in O(1).
+   Input: handle (NodeHandle)
+   Output: Pointer to the value, 0 for a null or stale handle
+   ----------------------------- */
+ElementType* ArrayBasedList::get(NodeHandle handle)
+{
+    if (handle.isNull() || !pool->isValid(handle)) {
+        cerr << "Error: Stale node handle" << endl;
+        return 0;
+    }
+    return &pool->data(handle.index);
+}
+
+const ElementType* ArrayBasedList::get(NodeHandle handle) const
+{
+    if (handle.isNull() || !pool->isValid(handle)) {
+        cerr << "Error: Stale node handle" << endl;
+        return 0;
+    }
+    return &pool->data(handle.index);
+}
+
+/* -----------------------------
+   isValid()
+   Purpose: Check whether a handle still names a live node.
+   Input: handle (NodeHandle)
+   Output: true unless null or stale
+   ----------------------------- */
+bool ArrayBasedList::isValid(NodeHandle handle) const
+{
+    return !handle.isNull() && pool->isValid(handle);
+}
+
+/* -----------------------------
+   ReadGuard
+   Purpose: Hold a reader slot of the list for the guard's lifetime.
+   Input: list (ArrayBasedList)
+   Output: Nodes reachable now are not recycled until the guard ends
+   ----------------------------- */
+ArrayBasedList::ReadGuard::ReadGuard(const ArrayBasedList& list)
+{
+    epochs = list.epochs;
+    slot = (epochs != 0) ? epochs->enter() : -1;
+}
+
+ArrayBasedList::ReadGuard::~ReadGuard()
+{
+    if (epochs != 0) {
+        epochs->exit(slot);
+    }
+}
+
+/* -----------------------------
+   enableConcurrentReaders()
+   Purpose: Let other threads read while this thread writes.
+   Input: None
+   Output: true unless the list could not take its own copy of shared nodes
+   ----------------------------- */
+bool ArrayBasedList::enableConcurrentReaders()
+{
+    if (!privatize(mySize)) {
+        return false; // Another list could still change shared nodes
+    }
+    if (epochs == 0) {
+        epochs = new EpochReclaimer(pool);
+    }
+    return true;
+}
+
+/* -----------------------------
+   disableConcurrentReaders()
+   Purpose: Go back to releasing removed nodes at once.
+   Input: None
+   Output: Retired nodes released to the pool
+   ----------------------------- */
+void ArrayBasedList::disableConcurrentReaders()
+{
+    delete epochs;
+    epochs = 0;
+}
+
+/* -----------------------------
+   hasConcurrentReaders()
+   Purpose: Report whether concurrent readers are enabled.
+   Input: None
+   Output: true if enabled
+   ----------------------------- */
+bool ArrayBasedList::hasConcurrentReaders() const
+{
+    return epochs != 0;
+}
+
+/* -----------------------------
+   loadHead() / publishHead()
+   Purpose: Read and write head so a reader sees a filled in first node.
+   Input: node (int) for publishHead
+   Output: Current head for loadHead
+   ----------------------------- */
+int ArrayBasedList::loadHead() const
+{
+    static_assert(sizeof(atomic<int>) == sizeof(int), "head is read as an atomic");
+    return reinterpret_cast<const atomic<int>&>(head).load(memory_order_acquire);
+}
+
+void ArrayBasedList::publishHead(int node)
+{
+    reinterpret_cast<atomic<int>&>(head).store(node, memory_order_release);
+}
+
+/* -----------------------------
+   releaseRemoved()
+   Purpose: Release an unlinked node, after the readers' grace period
+            if there may be readers.
+   Input: node (int)
+   Output: Node released or retired
+   ----------------------------- */
+void ArrayBasedList::releaseRemoved(int node)
+{
+    if (epochs != 0) {
+        pool->retire(node); // Handles go stale now, not after the grace period
+        epochs->retire(node);
+    }
+    else {
+        pool->releaseNode(node);
+    }
+}
+
+/* -----------------------------
+   refuseWithReaders()
+   Purpose: Stop an operation that relinks nodes readers may stand on.
+   Input: operation (name for the error)
+   Output: true (with an error) if concurrent readers are enabled
+   ----------------------------- */
+bool ArrayBasedList::refuseWithReaders(const char* operation) const
+{
+    if (epochs == 0) {
+        return false;
+    }
+    cerr << "Error: " << operation << " is not allowed with concurrent readers" << endl;
+    return true;
+}
+
+/* -----------------------------
+   mayShareWith()
+   Purpose: Decide whether a copy of source may share its nodes.
+   Input: source (ArrayBasedList)
+   Output: true if both lists can share a chain
+   ----------------------------- */
+bool ArrayBasedList::mayShareWith(const ArrayBasedList& source) const
+{
+    // Handles name source's own nodes, and readers need links nobody else changes
+    return pool == source.pool && !source.handlesOut && source.epochs == 0 && epochs == 0;
+}
+
+/* -----------------------------
+   unlinkAfter()
+   Purpose: Move one node from the list to a chain of removed nodes.
+   Input: prev, node (int), first/last of the removed chain (int)
+   Output: node unlinked and appended to first..last, or retired if
+           there are concurrent readers
+   ----------------------------- */
+void ArrayBasedList::unlinkAfter(int prev, int node, int& first, int& last)
+{
+    int following = pool->next(node);
+    if (prev == NULL_INDEX) {
+        publishHead(following);
+    }
+    else {
+        pool->publishNext(prev, following);
+    }
+    if (node == tail) {
+        tail = prev;
+    }
+    if (values != 0) {
+        values->erase(node);
+    }
+    if (epochs != 0) {
+        pool->retire(node); // Handles go stale now, not after the grace period
+        epochs->retire(node); // Keeps its link for readers standing on it
+        mySize--;
+        return;
+    }
+
+    pool->next(node) = NULL_INDEX;
+    if (first == NULL_INDEX) {
+        first = node;
+    }
+    else {
+        pool->next(last) = node;
+    }
+    last = node;
+    mySize--;
+}
+
+/* -----------------------------
+   finishRemoval()
+   Purpose: Release the nodes of a single-pass removal at once.
+   Input: first, last (int), count (size_t)
+   Output: Chain released, position index rebuilt
+   ----------------------------- */
+void ArrayBasedList::finishRemoval(int first, int last, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    cancelRelayout();
+    if (first != NULL_INDEX) {
+        pool->releaseChain(first, last, count); // Empty when the nodes were retired
+    }
+    fingerPos = -1;
+    if (index != 0) {
+        index->build(head, mySize);
+    }
+}
+
+/* -----------------------------
+   unique()
+   Purpose: Remove elements equal to their predecessor.
+   Input: None
+   Output: Number of elements removed
+   ----------------------------- */
+size_t ArrayBasedList::unique()
+{
+    if (!privatize(mySize)) {
+        return 0;
+    }
+    int first = NULL_INDEX, last = NULL_INDEX;
+    size_t removed = 0;
+    int prev = head;
+    int current = (head == NULL_INDEX) ? NULL_INDEX : pool->next(head);
+    while (current != NULL_INDEX) {
+        int following = pool->next(current);
+        if (pool->data(current) == pool->data(prev)) {
+            unlinkAfter(prev, current, first, last);
+            removed++;
+        }
+        else {
+            prev = current;
+        }
+        current = following;
+    }
+    finishRemoval(first, last, removed);
+    return removed;
+}
+
+/* -----------------------------
+   reverse()
+   Purpose: Reverse the list by turning every link around.
+   Input: None
+   Output: Elements in reverse order
+   ----------------------------- */
+void ArrayBasedList::reverse()
+{
+    if (refuseWithReaders("reverse") || mySize < 2 || !privatize(mySize)) {
+        return;
+    }
+    cancelRelayout();
+
+    int prev = NULL_INDEX;
+    int current = head;
+    while (current != NULL_INDEX) {
+        int following = pool->next(current);
+        pool->next(current) = prev;
+        prev = current;
+        current = following;
+    }
+    tail = head;
+    head = prev;
+    finishRelink();
+}
+
+/* -----------------------------
+   sort()
+   Purpose: Sort the list in ascending order (operator<).
+   Input: None
+   Output: true unless copying shared nodes failed
+   ----------------------------- */
+bool ArrayBasedList::sort()
+{
+    return sort(less<ElementType>());
+}
+
+/* -----------------------------
+   merge()
+   Purpose: Merge another list sorted by operator< into this one.
+   Input: other (ArrayBasedList)
+   Output: true if merged; other is empty
+   ----------------------------- */
+bool ArrayBasedList::merge(ArrayBasedList& other)
+{
+    return merge(other, less<ElementType>());
+}
+
+/* -----------------------------
+   finishRelink()
+   Purpose: Refresh position caches after nodes were reordered.
+   Input: None
+   Output: Finger dropped, position index rebuilt
+   ----------------------------- */
+void ArrayBasedList::finishRelink()
+{
+    fingerPos = -1;
+    if (index != 0) {
+        index->build(head, mySize);
+    }
+}
+
+/* -----------------------------
+   nodeAt()
+   Purpose: Resolve a position to a node index using the finger cache.
+   Input: position (int)
+   Output: Index of the node at position
+   ----------------------------- */
+int ArrayBasedList::nodeAt(int position)
+{
+    if (position == mySize - 1) {
+        return tail; // Last node is known directly
+    }
+
+    int current = head;
+    int i = 0;
+    if (fingerPos != -1 && fingerPos <= position) {
+        // Resume from the last resolved node
+        current = fingerIndex;
+        i = fingerPos;
+    }
+    if (index != 0 && position - i > FINGER_REACH) {
+        // Too far to walk: descend the skip list instead
+        current = index->nodeAt(head, position);
+        i = position;
+        STATS_ONLY(stepsTaken = 1;)
+    }
+    STATS_ONLY(stepsTaken += position - i;)
+    for (; i < position; i++) {
+        current = pool->next(current);
+    }
+
+    fingerPos = position;
+    fingerIndex = current;
+    return current;
+}
+
+/* -----------------------------
+   enablePositionIndex()
+   Purpose: Build a skip list index over the current list.
+   Input: None
+   Output: Index kept up to date by insert/remove/clear
+   ----------------------------- */
+void ArrayBasedList::enablePositionIndex()
+{
+    if (index == 0) {
+        index = new PositionIndex(pool);
+    }
+    index->build(head, mySize);
+}
+
+/* -----------------------------
+   disablePositionIndex()
+   Purpose: Drop the skip list index.
+   Input: None
+   Output: Positions resolved by walking again
+   ----------------------------- */
+void ArrayBasedList::disablePositionIndex()
+{
+    delete index;
+    index = 0;
+}
+
+/* -----------------------------
+   hasPositionIndex()
+   Purpose: Check whether the skip list index is kept.
+   Input: None
+   Output: true if enabled, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::hasPositionIndex() const
+{
+    return index != 0;
+}
+
+/* -----------------------------
+   enableValueIndex()
+   Purpose: Build a hash index over the values of the list.
+   Input: None
+   Output: Index kept up to date by insert/remove/clear
+   ----------------------------- */
+void ArrayBasedList::enableValueIndex()
+{
+    if (values == 0) {
+        values = new ValueIndex(pool);
+    }
+    values->clear();
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        values->insert(current);
+    }
+}
+
+/* -----------------------------
+   disableValueIndex()
+   Purpose: Drop the hash index.
+   Input: None
+   Output: search() scans again
+   ----------------------------- */
+void ArrayBasedList::disableValueIndex()
+{
+    delete values;
+    values = 0;
+}
+
+/* -----------------------------
+   hasValueIndex()
+   Purpose: Check whether the hash index is kept.
+   Input: None
+   Output: true if enabled, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::hasValueIndex() const
+{
+    return values != 0;
+}
+
+/* -----------------------------
+   positionOf()
+   Purpose: Turn a node index of this list back into a position.
+   Input: node (int)
+   Output: Position of node, -1 if it is not reached from head
+   ----------------------------- */
+int ArrayBasedList::positionOf(int node) const
+{
+    if (index != 0) {
+        return index->rankOf(node);
+    }
+
+    // Link-only walk: no data is compared
+    int position = 0;
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        if (current == node) {
+            return position;
+        }
+        position++;
+    }
+    return -1;
+}
+
+/* -----------------------------
+   insert()
+   Purpose: Insert a new element at a given position.
+   Input: value (ElementType), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::insert(const ElementType& value, int position)
+{
+    int newIndex = acquireFor(position);
+    if (newIndex == NULL_INDEX) {
+        return false;
+    }
+    pool->data(newIndex) = value;
+    linkNewNode(newIndex, position);
+    return true;
+}
+
+/* -----------------------------
+   insert() (move)
+   Purpose: Insert a value at a given position by moving it into the node.
+   Input: value (ElementType rvalue), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::insert(ElementType&& value, int position)
+{
+    int newIndex = acquireFor(position);
+    if (newIndex == NULL_INDEX) {
+        return false;
+    }
+    pool->data(newIndex) = std::move(value);
+    linkNewNode(newIndex, position);
+    return true;
+}
+
+/* -----------------------------
+   acquireFor()
+   Purpose: Validate an insert position and take a node from the pool.
+   Input: position (int)
+   Output: New node index, NULL_INDEX on failure
+   ----------------------------- */
+int ArrayBasedList::acquireFor(int position)
+{
+    // Validate position
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return NULL_INDEX;
+    }
+
+    // The new node's predecessor must not be shared
+    if (!privatize(position)) {
+        return NULL_INDEX;
+    }
+
+    // Acquire new node from pool
+    int newIndex = pool->acquireNode();
+    if (newIndex == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+    }
+    return newIndex;
+}
+
+/* -----------------------------
+   linkNewNode()
+   Purpose: Link a filled node in at a given position.
+   Input: newIndex (int), position (int)
+   Output: List, indexes and finger updated
+   ----------------------------- */
+void ArrayBasedList::linkNewNode(int newIndex, int position)
+{
+    STATS_ONLY(stepsTaken = 0;)
+    cancelRelayout();
+    if (values != 0) {
+        values->insert(newIndex);
+    }
+
+    // The node is filled in before a link to it is published
+    if (position == 0) {
+        // Insert at beginning
+        pool->next(newIndex) = head;
+        publishHead(newIndex);
+        if (tail == NULL_INDEX) {
+            tail = newIndex;
+        }
+    }
+    else if (position == mySize) {
+        // Append after tail
+        pool->next(newIndex) = NULL_INDEX;
+        pool->publishNext(tail, newIndex);
+        tail = newIndex;
+    }
+    else {
+        // Find node before insertion point
+        int prev = nodeAt(position - 1);
+        pool->next(newIndex) = pool->next(prev);
+        pool->publishNext(prev, newIndex);
+    }
+
+    mySize++; // Update size
+    if (index != 0) {
+        index->inserted(position, newIndex);
+    }
+
+    // Remember the new node; nodes after it have shifted anyway
+    fingerPos = position;
+    fingerIndex = newIndex;
+    STATS_ONLY(insertSteps.record(stepsTaken);)
+}
+
+/* -----------------------------
+   remove()
+   Purpose: Remove a node at a given position.
+   Input: position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::remove(int position)
+{
+    if (position < 0 || position >= mySize || empty()) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+
+    if (!privatize(position)) {
+        return false;
+    }
+
+    STATS_ONLY(stepsTaken = 0;)
+    cancelRelayout();
+    bool inSharedTail = (position >= mySize - sharedTail);
+    int toRemove;
+    if (position == 0) {
+        // Remove head
+        toRemove = head;
+        publishHead(pool->next(head));
+        if (head == NULL_INDEX) {
+            tail = NULL_INDEX;
+        }
+
+        // Every remaining node moved one position down
+        if (fingerPos == 0) {
+            fingerPos = -1;
+        }
+        else if (fingerPos > 0) {
+            fingerPos--;
+        }
+    }
+    else {
+        // Find node before removal point (leaves the finger on it)
+        int prev = nodeAt(position - 1);
+        toRemove = pool->next(prev);
+        pool->publishNext(prev, pool->next(toRemove));
+        if (toRemove == tail) {
+            tail = prev;
+        }
+    }
+
+    if (values != 0) {
+        values->erase(toRemove);
+    }
+    if (pool->isShared(toRemove)) {
+        // Another list keeps the node: only move our reference past it
+        int following = pool->next(toRemove);
+        if (following != NULL_INDEX) {
+            pool->addReference(following);
+        }
+        pool->dropReference(toRemove);
+    }
+    else {
+        releaseRemoved(toRemove);
+    }
+    if (inSharedTail) {
+        sharedTail--;
+    }
+    mySize--; // Update size
+    if (index != 0) {
+        index->removed(position);
+    }
+    STATS_ONLY(removeSteps.record(stepsTaken);)
+    return true;
+}
+
+/* -----------------------------
+   push_back()
+   Purpose: Append a value after the tail.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::push_back(const ElementType& value)
+{
+    return insert(value, mySize);
+}
+
+/* -----------------------------
+   push_back() (move)
+   Purpose: Append a value by moving it into the node.
+   Input: value (ElementType rvalue)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::push_back(ElementType&& value)
+{
+    return insert(std::move(value), mySize);
+}
+
+/* -----------------------------
+   push_front()
+   Purpose: Insert a value before the head.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::push_front(const ElementType& value)
+{
+    return insert(value, 0);
+}
+
+/* -----------------------------
+   push_front() (move)
+   Purpose: Prepend a value by moving it into the node.
+   Input: value (ElementType rvalue)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::push_front(ElementType&& value)
+{
+    return insert(std::move(value), 0);
+}
+
+/* -----------------------------
+   pop_front()
+   Purpose: Remove the head node.
+   Input: None
+   Output: true if successful, false if the list is empty
+   ----------------------------- */
+bool ArrayBasedList::pop_front()
+{
+    return remove(0);
+}
+
+/* -----------------------------
+   insertRange()
+   Purpose: Insert several values as one chain.
+   Input: items (vector of ElementType), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::insertRange(const vector<ElementType>& items, int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    if (items.empty()) {
+        return true;
+    }
+    if (!privatize(position)) {
+        return false;
+    }
+
+    int last;
+    int first = pool->acquireNodes(items.size(), last);
+    if (first == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return false;
+    }
+
+    cancelRelayout();
+
+    // Fill the chain in one pass
+    int current = first;
+    for (size_t i = 0; i < items.size(); i++) {
+        pool->data(current) = items[i];
+        if (values != 0) {
+            values->insert(current);
+        }
+        current = pool->next(current);
+    }
+
+    // Splice first..last in at position
+    if (position == 0) {
+        pool->next(last) = head;
+        publishHead(first);
+        if (tail == NULL_INDEX) {
+            tail = last;
+        }
+    }
+    else if (position == mySize) {
+        pool->publishNext(tail, first);
+        tail = last;
+    }
+    else {
+        int prev = nodeAt(position - 1);
+        pool->next(last) = pool->next(prev);
+        pool->publishNext(prev, first);
+    }
+
+    int oldSize = mySize;
+    mySize += int(items.size());
+    if (index != 0) {
+        if (int(items.size()) >= oldSize) {
+            index->build(head, mySize); // Cheaper than one update per item
+        }
+        else {
+            current = first;
+            for (size_t i = 0; i < items.size(); i++) {
+                index->inserted(position + int(i), current);
+                current = pool->next(current);
+            }
+        }
+    }
+
+    fingerPos = position;
+    fingerIndex = first;
+    return true;
+}
+
+/* -----------------------------
+   assign()
+   Purpose: Replace the contents with several values.
+   Input: items (vector of ElementType), or items (array) and count
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ArrayBasedList::assign(const vector<ElementType>& items)
+{
+    return assign(items.data(), items.size());
+}
+
+bool ArrayBasedList::assign(const ElementType* items, size_t count)
+{
+    int first = NULL_INDEX;
+    int last = NULL_INDEX;
+    if (count > 0) {
+        // Take the new nodes first so a failure leaves the list intact
+        first = pool->acquireNodes(count, last);
+        if (first == NULL_INDEX) {
+            cerr << "Error: Node pool exhausted" << endl;
+            return false;
+        }
+    }
+
+    int current = first;
+    for (size_t i = 0; i < count; i++) {
+        pool->data(current) = items[i];
+        current = pool->next(current);
+    }
+
+    adoptChain(first, last, count);
+    return true;
+}
+
+/* -----------------------------
+   adoptChain()
+   Purpose: Make a filled chain the new contents of the list.
+   Input: first, last (int), count (size_t)
+   Output: Old nodes released, indexes rebuilt
+   ----------------------------- */
+void ArrayBasedList::adoptChain(int first, int last, size_t count)
+{
+    releaseAll();
+    publishHead(first);
+    tail = last;
+    mySize = int(count);
+    rebuildIndexes();
+}
+
+/* -----------------------------
+   relayout()
+   Purpose: Renumber the nodes to follow list order, all in one call.
+   Input: None
+   Output: true if the list was moved
+   ----------------------------- */
+bool ArrayBasedList::relayout()
+{
+    if (refuseWithReaders("relayout")) {
+        return false;
+    }
+    cancelRelayout();
+    if (!privatize(mySize) || !pool->compact(head, tail, size_t(mySize))) {
+        return false;
+    }
+    fingerPos = -1;
+    rebuildIndexes(); // Every node may have a new index
+    return true;
+}
+
+/* -----------------------------
+   relayoutStep()
+   Purpose: Advance an incremental relayout by bounded work: first
+            collect the list's nodes, then give position k the k-th
+            lowest of them, one swap at a time.
+   Input: budget (size_t), nodes collected or slots examined this call
+   Output: RELAYOUT_DONE once the pass is complete, RELAYOUT_FAILED if
+           it cannot go on
+   ----------------------------- */
+RelayoutProgress ArrayBasedList::relayoutStep(size_t budget)
 {
-    pool = externalPool;       // Node pool used for memory management
-    head = NULL_INDEX;         // Head index starts as null
-    mySize = 0;                // Start with empty list
+    if (refuseWithReaders("relayoutStep")) {
+        return RELAYOUT_FAILED;
+    }
+    if (sharedTail > 0) {
+        // Nodes shared with copies cannot move: first copy them, budget at a time
+        int ownPrefix = mySize - sharedTail;
+        if (!privatize(int(min(size_t(mySize), size_t(ownPrefix) + budget)))) {
+            return RELAYOUT_FAILED;
+        }
+        return RELAYOUT_PENDING;
+    }
+    if (relayoutPass == 0) {
+        if (mySize < 2) {
+            return RELAYOUT_DONE;
+        }
+        relayoutPass = new RelayoutPass; // Tables grow with the nodes collected, not the pool
+        relayoutPass->walk = head;
+        relayoutPass->placed = 0;
+        relayoutPass->slot = 0;
+    }
+
+    RelayoutPass& pass = *relayoutPass;
+    size_t work = 0;
+    while (pass.walk != NULL_INDEX && work < budget) {
+        pass.occupant[pass.walk] = int(pass.at.size());
+        pass.at.push_back(pass.walk);
+        pass.walk = pool->next(pass.walk);
+        work++;
+    }
+
+    while (pass.walk == NULL_INDEX && pass.placed < pass.at.size() && work < budget) {
+        work++;
+        unordered_map<int, int>::const_iterator owner = pass.occupant.find(int(pass.slot));
+        if (owner != pass.occupant.end()) {
+            // slot is the lowest unplaced node of ours: position placed gets it
+            if (owner->second != int(pass.placed)) {
+                swapPositions(int(pass.placed), owner->second);
+            }
+            pass.placed++;
+        }
+        pass.slot++;
+    }
+
+    if (pass.walk == NULL_INDEX && pass.placed == pass.at.size()) {
+        cancelRelayout();
+        return RELAYOUT_DONE;
+    }
+    return RELAYOUT_PENDING;
 }
 
 /* -----------------------------
-   Destructor
-   Purpose: Release all nodes back to the pool.
-   Input: None
-   Output: Frees all nodes, resets list to empty
+   swapPositions()
+   Purpose: Let two positions trade nodes during relayoutStep().
+   Input: first, second (positions)
+   Output: List, indexes and pass state updated
    ----------------------------- */
-ArrayBasedList::~ArrayBasedList()
+void ArrayBasedList::swapPositions(int first, int second)
 {
-    int current = head;
-    while (current != NULL_INDEX) {
-        int next = pool->getNode(current).next; // Save next before releasing
-        pool->releaseNode(current);             // Return node to pool
-        current = next;
+    vector<int>& at = relayoutPass->at;
+    int a = at[first];
+    int b = at[second];
+
+    if (values != 0) {
+        values->erase(a); // Hashed by value: take both out before the swap
+        values->erase(b);
     }
-    head = NULL_INDEX;
-    mySize = 0;
+    swap(pool->data(a), pool->data(b));
+    pool->retire(a); // Handles named the values, which have moved
+    pool->retire(b);
+    at[first] = b;
+    at[second] = a;
+    relayoutPass->occupant[a] = second;
+    relayoutPass->occupant[b] = first;
+    if (values != 0) {
+        values->insert(a);
+        values->insert(b);
+    }
+
+    // Relink around both positions from the position table
+    int around[4] = { first - 1, first, second - 1, second };
+    for (int i = 0; i < 4; i++) {
+        int position = around[i];
+        if (position < 0) {
+            head = at[0];
+        }
+        else {
+            pool->next(at[position]) = (position + 1 < mySize) ? at[position + 1] : NULL_INDEX;
+        }
+    }
+    tail = at[mySize - 1];
+
+    if (index != 0) {
+        index->removed(first);
+        index->inserted(first, b);
+        index->removed(second);
+        index->inserted(second, a);
+    }
+    fingerPos = -1;
 }
 
 /* -----------------------------
-   empty()
-   Purpose: Check if the list is empty.
+   cancelRelayout()
+   Purpose: Drop the state of an incremental relayout.
    Input: None
-   Output: true if empty, false otherwise
+   Output: relayoutPass is 0
    ----------------------------- */
-bool ArrayBasedList::empty() const {
-    return head == NULL_INDEX;
+void ArrayBasedList::cancelRelayout()
+{
+    if (relayoutPass != 0) {
+        delete relayoutPass;
+        relayoutPass = 0;
+    }
 }
 
 /* -----------------------------
-   length()
-   Purpose: Return the number of active elements in the list.
+   serializedSize()
+   Purpose: Size of the binary form of the list.
    Input: None
-   Output: Count of nodes in the list
+   Output: Bytes written by exportTo()
    ----------------------------- */
-int ArrayBasedList::length() const
+size_t ArrayBasedList::serializedSize() const
 {
-    return mySize;
+    size_t bytes = STREAM_HEADER;
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        bytes += Codec::size(pool->data(current));
+    }
+    return bytes;
 }
 
-
 /* -----------------------------
-   clear()
-   Purpose: Remove all nodes from the list and return them to the pool.
-   Input: None
-   Output: List becomes empty and all nodes are released
+   exportTo()
+   Purpose: Write the list into a caller-supplied buffer.
+   Input: buffer (char*), capacity (size_t)
+   Output: Bytes written, 0 if the buffer is too small
    ----------------------------- */
-void ArrayBasedList::clear()
+size_t ArrayBasedList::exportTo(char* buffer, size_t capacity) const
 {
-    int current = head;
-
-    while (current != NULL_INDEX) {
-        int next = pool->getNode(current).next; // Save next
-        pool->releaseNode(current);             // Return node to pool
-        current = next;
+    size_t bytes = serializedSize();
+    if (capacity < bytes) {
+        cerr << "Error: Buffer too small for the list (" << bytes << " bytes)" << endl;
+        return 0;
     }
 
-    head = NULL_INDEX;
-    mySize = 0;
+    writeStreamHeader(buffer, size_t(mySize), bytes - STREAM_HEADER);
+    char* out = buffer + STREAM_HEADER;
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        out = Codec::write(pool->data(current), out);
+    }
+    return bytes;
 }
 
 /* -----------------------------
-   getHead()
-   Purpose: Retrieve the index of the head node.
-   Input: None
-   Output: Index of the first node in the list
+   exportTo()
+   Purpose: Write the list to a file descriptor in STREAM_BLOCK chunks.
+   Input: fd (int)
+   Output: true if every byte was written
    ----------------------------- */
-int ArrayBasedList::getHead() const
+bool ArrayBasedList::exportTo(int fd) const
 {
-    return head;
+    vector<char> block(STREAM_BLOCK);
+    writeStreamHeader(block.data(), size_t(mySize), serializedSize() - STREAM_HEADER);
+    size_t used = STREAM_HEADER;
+
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        const ElementType& value = pool->data(current);
+        size_t size = Codec::size(value);
+        if (used + size > block.size()) {
+            if (!sendAll(fd, block.data(), used)) {
+                cerr << "Error: Could not write the list" << endl;
+                return false;
+            }
+            used = 0;
+        }
+        if (size > block.size()) {
+            // Too big for a block: encode it on its own
+            vector<char> encoded(size);
+            Codec::write(value, encoded.data());
+            if (!sendAll(fd, encoded.data(), size)) {
+                cerr << "Error: Could not write the list" << endl;
+                return false;
+            }
+            continue;
+        }
+        Codec::write(value, block.data() + used);
+        used += size;
+    }
+
+    if (!sendAll(fd, block.data(), used)) {
+        cerr << "Error: Could not write the list" << endl;
+        return false;
+    }
+    return true;
 }
 
 /* -----------------------------
-   insert()
-   Purpose: Insert a new element at a given position.
-   Input: value (ElementType), position (int)
-   Output: true if successful, false otherwise
+   readStreamHeader()
+   Purpose: Check a stream header and extract its counts.
+   Input: header (char*), available (size_t)
+   Output: true with count and bytes set if the header is usable
    ----------------------------- */
-bool ArrayBasedList::insert(const ElementType& value, int position)
+bool ArrayBasedList::readStreamHeader(const char* header, size_t available, size_t& count, size_t& bytes)
 {
-    // Validate position
-    if (position < 0 || position > mySize) {
-        cerr << "Error: Invalid position" << endl;
+    unsigned int version;
+    unsigned long long count64, bytes64;
+    if (available < STREAM_HEADER || memcmp(header, STREAM_MAGIC, 4) != 0) {
+        cerr << "Error: Data is not a serialized list" << endl;
         return false;
     }
-
-    // Acquire new node from pool
-    int newIndex = pool->acquireNode();
-    if (newIndex == NULL_INDEX) {
-        cerr << "Error: Node pool exhausted" << endl;
+    memcpy(&version, header + 4, 4);
+    memcpy(&count64, header + 8, 8);
+    memcpy(&bytes64, header + 16, 8);
+    if (version != STREAM_VERSION) {
+        cerr << "Error: Unsupported list format version " << version << endl;
+        return false;
+    }
+    // Every element takes at least its 4-byte length
+    if (count64 > (unsigned long long)INT_MAX || bytes64 < 4 * count64 ||
+        bytes64 > (unsigned long long)(size_t(-1) - STREAM_HEADER)) {
+        cerr << "Error: Corrupt list header" << endl;
         return false;
     }
+    count = size_t(count64);
+    bytes = size_t(bytes64);
+    return true;
+}
+
+/* -----------------------------
+   importFrom()
+   Purpose: Replace the list with one serialized in a buffer.
+   Input: buffer (char*), length (size_t)
+   Output: Bytes consumed, 0 on failure (list unchanged)
+   ----------------------------- */
+size_t ArrayBasedList::importFrom(const char* buffer, size_t length)
+{
+    size_t count, bytes;
+    if (!readStreamHeader(buffer, length, count, bytes)) {
+        return 0;
+    }
+    if (length - STREAM_HEADER < bytes) {
+        cerr << "Error: Serialized list is truncated" << endl;
+        return 0;
+    }
 
-    pool->getNode(newIndex).data = value;
+    int first = NULL_INDEX;
+    int last = NULL_INDEX;
+    if (count > 0) {
+        first = pool->acquireNodes(count, last);
+        if (first == NULL_INDEX) {
+            cerr << "Error: Node pool exhausted" << endl;
+            return 0;
+        }
+    }
 
-    if (position == 0) {
-        // Insert at beginning
-        pool->getNode(newIndex).next = head;
-        head = newIndex;
+    // Decode straight into the new chain
+    const char* in = buffer + STREAM_HEADER;
+    const char* end = in + bytes;
+    for (int current = first; current != NULL_INDEX && in != 0; current = pool->next(current)) {
+        in = Codec::read(in, end, pool->data(current));
     }
-    else {
-        // Traverse to node before insertion point
-        int prev = head;
-        for (int i = 0; i < position - 1; i++) {
-            prev = pool->getNode(prev).next;
+    if (in != end) {
+        cerr << "Error: Corrupt serialized list" << endl;
+        if (first != NULL_INDEX) {
+            pool->releaseChain(first, last, count);
         }
-        pool->getNode(newIndex).next = pool->getNode(prev).next;
-        pool->getNode(prev).next = newIndex;
+        return 0;
     }
 
-    mySize++; // Update size
-    return true;
+    adoptChain(first, last, count);
+    return STREAM_HEADER + bytes;
 }
 
 /* -----------------------------
-   remove()
-   Purpose: Remove a node at a given position.
-   Input: position (int)
-   Output: true if successful, false otherwise
+   importFrom()
+   Purpose: Replace the list with one read from a file descriptor.
+   Input: fd (int)
+   Output: true if successful, false otherwise (list unchanged)
    ----------------------------- */
-bool ArrayBasedList::remove(int position)
+bool ArrayBasedList::importFrom(int fd)
 {
-    if (position < 0 || position >= mySize || empty()) {
-        cerr << "Error: Invalid position" << endl;
+    char header[STREAM_HEADER];
+    size_t count, bytes;
+    if (!receiveAll(fd, header, STREAM_HEADER)) {
+        cerr << "Error: Could not read the list header" << endl;
+        return false;
+    }
+    if (!readStreamHeader(header, STREAM_HEADER, count, bytes)) {
         return false;
     }
 
-    int toRemove;
-    if (position == 0) {
-        // Remove head
-        toRemove = head;
-        head = pool->getNode(head).next;
+    // Decode each block into the chain as it arrives. Nodes are taken a
+    // batch at a time, so a header claiming more elements than the peer
+    // sends cannot grow the pool ahead of the data
+    int first = NULL_INDEX;
+    int last = NULL_INDEX;
+    size_t taken = 0;
+    vector<char> block(STREAM_BLOCK);
+    size_t pos = 0, held = 0, remaining = bytes;
+    bool ok = true;
+    bool exhausted = false;
+    int current = NULL_INDEX;
+    for (size_t i = 0; ok && i < count; i++) {
+        if (i == taken) {
+            int batchLast;
+            size_t batch = min(count - taken, size_t(STREAM_BLOCK / 4)); // One block holds no more
+            int batchFirst = pool->acquireNodes(batch, batchLast);
+            if (batchFirst == NULL_INDEX) {
+                exhausted = true;
+                break;
+            }
+            if (first == NULL_INDEX) {
+                first = batchFirst;
+            }
+            else {
+                pool->next(last) = batchFirst;
+            }
+            last = batchLast;
+            taken += batch;
+            current = batchFirst;
+        }
+
+        const char* next;
+        while (ok && (next = Codec::read(block.data() + pos, block.data() + held,
+                                         pool->data(current))) == 0) {
+            size_t need = 4;
+            if (held - pos >= 4) {
+                unsigned int length;
+                memcpy(&length, block.data() + pos, 4);
+                need += length;
+            }
+            ok = fillBlock(fd, block, pos, held, remaining, need);
+        }
+        if (ok) {
+            pos = size_t(next - block.data());
+            current = pool->next(current);
+        }
     }
-    else {
-        // Traverse to node before removal point
-        int prev = head;
-        for (int i = 0; i < position - 1; i++) {
-            prev = pool->getNode(prev).next;
+
+    if (exhausted || !ok || pos != held || remaining != 0) {
+        if (exhausted) {
+            cerr << "Error: Node pool exhausted" << endl;
         }
-        toRemove = pool->getNode(prev).next;
-        pool->getNode(prev).next = pool->getNode(toRemove).next;
+        else {
+            cerr << "Error: Corrupt or truncated serialized list" << endl;
+        }
+        if (first != NULL_INDEX) {
+            pool->releaseChain(first, last, taken);
+        }
+        return false;
     }
 
-    pool->releaseNode(toRemove);
-    mySize--; // Update size
+    adoptChain(first, last, count);
     return true;
 }
 
@@ -182,20 +1806,112 @@ bool ArrayBasedList::remove(int position)
    ----------------------------- */
 int ArrayBasedList::search(const ElementType& value) const
 {
+    if (epochs != 0) {
+        return concurrentSearch(value); // Indexes belong to the writer
+    }
+    if (values != 0) {
+        STATS_ONLY(stepsTaken = 0;)
+        int found = indexedSearch(value);
+        STATS_ONLY(searchSteps.record(stepsTaken);)
+        return found;
+    }
+    if constexpr (PayloadScan<ElementType>::AVAILABLE) {
+        // Fixed-width keys: scan the payload arrays, then map to a position.
+        // Values of other lists on the pool would only be false matches
+        if (pool->length() == size_t(mySize)) {
+            long found = pool->findInChain(head, value);
+            STATS_ONLY(searchSteps.record(found < 0 ? 0 : size_t(found));)
+            return int(found);
+        }
+    }
+
     int current = head;
     int position = 0;
 
     while (current != NULL_INDEX) {
-        if (pool->getNode(current).data == value) {
+        if (pool->data(current) == value) {
+            STATS_ONLY(searchSteps.record(position + 1);)
             return position;
         }
-        current = pool->getNode(current).next;
+        current = pool->next(current);
         position++;
     }
 
+    STATS_ONLY(searchSteps.record(position);)
     return -1; // Not found
 }
 
+/* -----------------------------
+   indexedSearch()
+   Purpose: Search through the hash index, keeping first-match semantics.
+   Input: value (ElementType)
+   Output: Position of the first node holding value, -1 otherwise
+   ----------------------------- */
+int ArrayBasedList::indexedSearch(const ElementType& value) const
+{
+    ValueIndex::Probe probe = values->startProbe(value);
+    int first = values->findNext(value, probe);
+    if (first == NULL_INDEX) {
+        return -1;
+    }
+    int second = values->findNext(value, probe);
+    if (second == NULL_INDEX) {
+        int position = positionOf(first); // Unique value
+        STATS_ONLY(stepsTaken = (index != 0) ? 1 : position + 1;)
+        return position;
+    }
+
+    // Duplicates: the earliest node wins
+    if (index != 0) {
+        int best = index->rankOf(first);
+        STATS_ONLY(stepsTaken = 1;)
+        for (int node = second; node != NULL_INDEX; node = values->findNext(value, probe)) {
+            STATS_ONLY(stepsTaken++;)
+            int position = index->rankOf(node);
+            if (position < best) {
+                best = position;
+            }
+        }
+        return best;
+    }
+
+    vector<int> matches;
+    matches.push_back(first);
+    for (int node = second; node != NULL_INDEX; node = values->findNext(value, probe)) {
+        matches.push_back(node);
+    }
+    std::sort(matches.begin(), matches.end());
+
+    int position = 0;
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        if (binary_search(matches.begin(), matches.end(), current)) {
+            STATS_ONLY(stepsTaken = matches.size() + position + 1;)
+            return position;
+        }
+        position++;
+    }
+    return -1;
+}
+
+/* -----------------------------
+   concurrentSearch()
+   Purpose: Search by walking the list as a reader.
+   Input: value (ElementType)
+   Output: Position of value if found, -1 otherwise
+   ----------------------------- */
+int ArrayBasedList::concurrentSearch(const ElementType& value) const
+{
+    ReadGuard guard(*this);
+    int position = 0;
+    for (int current = loadHead(); current != NULL_INDEX; current = pool->loadNext(current)) {
+        if (pool->data(current) == value) {
+            return position;
+        }
+        position++;
+    }
+    return -1;
+}
+
 /* -----------------------------
    display()
    Purpose: Print the list contents to console.
@@ -207,15 +1923,15 @@ void ArrayBasedList::display() const
     int current = head;
     cout << "List: ";
     while (current != NULL_INDEX) {
-        cout << pool->getNode(current).data << " ";
-        current = pool->getNode(current).next;
+        cout << pool->data(current) << " ";
+        current = pool->next(current);
     }
     cout << endl;
 }
 
 /* -----------------------------
    Copy Constructor
-   Purpose: Create a deep copy of another list.
+   Purpose: Create a copy-on-write copy of another list in O(1).
    Input: source (ArrayBasedList)
    Output: A new list identical to source
    ----------------------------- */
@@ -223,74 +1939,274 @@ ArrayBasedList::ArrayBasedList(const ArrayBasedList& source)
 {
     pool = source.pool;
     head = NULL_INDEX;
-    mySize = source.mySize;
-
-    if (source.head == NULL_INDEX)
-        return;
-
-    int srcCurrent = source.head;
-    int prevNew = NULL_INDEX;
-
-    while (srcCurrent != NULL_INDEX) {
-        int newIndex = pool->acquireNode();
-        pool->getNode(newIndex).data = pool->getNode(srcCurrent).data;
-
-        if (head == NULL_INDEX) {
-            head = newIndex;
-        }
-        else {
-            pool->getNode(prevNew).next = newIndex;
-        }
+    tail = NULL_INDEX;
+    mySize = 0;
+    fingerPos = -1;
+    fingerIndex = NULL_INDEX;
+    index = 0;
+    values = 0;
+    rootSlot = -1;
+    relayoutPass = 0;
+    sharedTail = 0;
+    handlesOut = false;
+    epochs = 0;
+    STATS_ONLY(stepsTaken = 0;)
 
-        prevNew = newIndex;
-        srcCurrent = pool->getNode(srcCurrent).next;
+    if (source.index != 0) {
+        index = new PositionIndex(pool);
+    }
+    if (source.values != 0) {
+        values = new ValueIndex(pool);
+    }
+    if (source.epochs != 0) {
+        epochs = new EpochReclaimer(pool);
     }
 
-    if (prevNew != NULL_INDEX)
-        pool->getNode(prevNew).next = NULL_INDEX;
+    if (mayShareWith(source)) {
+        shareNodes(source);
+    }
+    else {
+        copyNodes(source); // Handles or readers need a chain of our own
+    }
 }
 
 /* -----------------------------
    operator=
-   Purpose: Assignment operator for deep copy.
+   Purpose: Assignment operator; shares source's nodes copy-on-write.
    Input: source (ArrayBasedList)
    Output: *this updated to match source
    ----------------------------- */
 ArrayBasedList& ArrayBasedList::operator=(const ArrayBasedList& source)
 {
     if (this != &source) {
-        // Clear current list
-        int current = head;
-        while (current != NULL_INDEX) {
-            int next = pool->getNode(current).next;
-            pool->releaseNode(current);
-            current = next;
+        if (rootSlot != -1) {
+            pool->setRoot(rootSlot, NULL_INDEX, NULL_INDEX, 0); // Must not name released nodes
         }
-        head = NULL_INDEX;
-        mySize = 0;
+        releaseAll(); // Current nodes go back as one chain
+        if (mayShareWith(source)) {
+            shareNodes(source);
+        }
+        else {
+            copyNodes(source); // Nodes cannot be shared across pools
+        }
+        if (rootSlot != -1) {
+            saveRoot(rootSlot); // The slot now records the new chain
+        }
+    }
+    return *this;
+}
+
+/* -----------------------------
+   Move Constructor
+   Purpose: Take over another list's nodes in O(1).
+   Input: source (ArrayBasedList rvalue)
+   Output: A list holding source's elements; source is empty
+   ----------------------------- */
+ArrayBasedList::ArrayBasedList(ArrayBasedList&& source) noexcept
+{
+    pool = source.pool;
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+    fingerPos = source.fingerPos;
+    fingerIndex = source.fingerIndex;
+    index = source.index;
+    values = source.values;
+    rootSlot = source.rootSlot;
+    relayoutPass = source.relayoutPass;
+    sharedTail = source.sharedTail;
+    handlesOut = source.handlesOut;
+    epochs = source.epochs;
+    STATS_ONLY(stepsTaken = 0;)
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+    source.fingerPos = -1;
+    source.index = 0;
+    source.values = 0;
+    source.rootSlot = -1;
+    source.relayoutPass = 0;
+    source.sharedTail = 0;
+    source.handlesOut = false;
+    source.epochs = 0;
+}
+
+/* -----------------------------
+   operator= (move)
+   Purpose: Release the current nodes and take over source's.
+   Input: source (ArrayBasedList rvalue)
+   Output: *this holds source's elements; source is empty
+   ----------------------------- */
+ArrayBasedList& ArrayBasedList::operator=(ArrayBasedList&& source)
+{
+    if (this == &source) {
+        return *this;
+    }
+    if (pool != source.pool) {
+        return *this = static_cast<const ArrayBasedList&>(source); // Nodes cannot change pools
+    }
+
+    int slot = rootSlot;
+    if (slot != -1) {
+        pool->setRoot(slot, NULL_INDEX, NULL_INDEX, 0); // Must not name released nodes
+    }
+    releaseAll();
+    delete index;
+    delete values;
+    delete epochs;
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+    fingerPos = source.fingerPos;
+    fingerIndex = source.fingerIndex;
+    index = source.index;
+    values = source.values;
+    rootSlot = source.rootSlot;
+    relayoutPass = source.relayoutPass;
+    sharedTail = source.sharedTail;
+    handlesOut = source.handlesOut;
+    epochs = source.epochs;
 
-        // Copy from source
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+    source.fingerPos = -1;
+    source.index = 0;
+    source.values = 0;
+    source.rootSlot = -1;
+    source.relayoutPass = 0;
+    source.sharedTail = 0;
+    source.handlesOut = false;
+    source.epochs = 0;
+
+    if (slot != -1) {
+        if (rootSlot != -1 && rootSlot != slot) {
+            pool->setRoot(rootSlot, NULL_INDEX, NULL_INDEX, 0); // A list is kept in one slot
+        }
+        rootSlot = -1;
+        saveRoot(slot); // The slot now records the new chain
+    }
+    return *this;
+}
+
+/* -----------------------------
+   shareNodes()
+   Purpose: Make this empty list share source's chain.
+   Input: source (ArrayBasedList in the same pool)
+   Output: Both lists treat every node as possibly shared
+   ----------------------------- */
+void ArrayBasedList::shareNodes(const ArrayBasedList& source)
+{
+    if (source.head != NULL_INDEX) {
+        pool->addReference(source.head); // Our head is one more reference
+        head = source.head;
+        tail = source.tail;
         mySize = source.mySize;
-        int srcCurrent = source.head;
-        int prevNew = NULL_INDEX;
+        fingerPos = source.fingerPos;
+        fingerIndex = source.fingerIndex;
+        sharedTail = mySize;
+        source.sharedTail = source.mySize;
+    }
+    rebuildIndexes();
+}
+
+/* -----------------------------
+   privatize()
+   Purpose: Give the list its own copy of every shared node among the
+            first count positions, so they can be changed.
+   Input: count (int), watch (a node index to follow through copying)
+   Output: true unless the pool ran out; watch names its copy if copied
+   ----------------------------- */
+bool ArrayBasedList::privatize(int count)
+{
+    int unused = NULL_INDEX;
+    return privatize(count, unused);
+}
 
-        while (srcCurrent != NULL_INDEX) {
-            int newIndex = pool->acquireNode();
-            pool->getNode(newIndex).data = pool->getNode(srcCurrent).data;
+bool ArrayBasedList::privatize(int count, int& watch)
+{
+    int ownPrefix = mySize - sharedTail;
+    if (count <= ownPrefix) {
+        return true;
+    }
+
+    cancelRelayout();
+    int prev = (ownPrefix == 0) ? NULL_INDEX : nodeAt(ownPrefix - 1);
+    int current = (prev == NULL_INDEX) ? head : pool->next(prev);
+    for (int position = ownPrefix; position < count; position++) {
+        if (pool->isShared(current)) {
+            int copy = pool->acquireNode();
+            if (copy == NULL_INDEX) {
+                cerr << "Error: Node pool exhausted" << endl;
+                fingerPos = -1;
+                return false;
+            }
 
-            if (head == NULL_INDEX) {
-                head = newIndex;
+            // The copy takes over our reference; the rest stays shared
+            pool->data(copy) = pool->data(current);
+            int following = pool->next(current);
+            pool->next(copy) = following;
+            if (following != NULL_INDEX) {
+                pool->addReference(following);
+            }
+            pool->dropReference(current);
+            if (prev == NULL_INDEX) {
+                head = copy;
             }
             else {
-                pool->getNode(prevNew).next = newIndex;
+                pool->next(prev) = copy;
             }
-
-            prevNew = newIndex;
-            srcCurrent = pool->getNode(srcCurrent).next;
+            if (current == tail) {
+                tail = copy;
+            }
+            if (index != 0) {
+                index->removed(position);
+                index->inserted(position, copy);
+            }
+            if (values != 0) {
+                values->erase(current);
+                values->insert(copy);
+            }
+            if (current == watch) {
+                watch = copy;
+            }
+            current = copy;
         }
+        prev = current;
+        current = pool->next(current);
+        sharedTail--;
+    }
+
+    fingerPos = count - 1; // Resume here next time
+    fingerIndex = prev;
+    return true;
+}
 
-        if (prevNew != NULL_INDEX)
-            pool->getNode(prevNew).next = NULL_INDEX;
+/* -----------------------------
+   copyNodes()
+   Purpose: Copy source's nodes into this empty list as one chain.
+   Input: source (ArrayBasedList)
+   Output: List equal to source, indexes rebuilt
+   ----------------------------- */
+void ArrayBasedList::copyNodes(const ArrayBasedList& source)
+{
+    if (source.mySize > 0) {
+        int last;
+        int first = pool->acquireNodes(source.mySize, last);
+        if (first == NULL_INDEX) {
+            cerr << "Error: Node pool exhausted" << endl;
+        }
+        else {
+            int current = first;
+            for (int src = source.head; src != NULL_INDEX; src = source.pool->next(src)) {
+                pool->data(current) = source.pool->data(src);
+                current = pool->next(current);
+            }
+            publishHead(first);
+            tail = last;
+            mySize = source.mySize;
+        }
     }
-    return *this;
-}
\ No newline at end of file
+    rebuildIndexes();
+}
@@ -8,25 +8,153 @@
     Constructor
     Destructor
     empty:Check if list is empty
-    insert:Insert an item at a position
+    insert:Insert an item at a position (copied or moved in)
+    emplace:Construct an item in its pool slot at a position
     remove:Delete an item at a position
+    push_back:Append an item in O(1) using the tail index
+    push_front:Prepend an item in O(1)
+    pop_front:Remove the first item in O(1)
+    insertRange:Insert several items at a position as one chain
+    assign:Replace the contents with several items
+    enablePositionIndex:Keep a skip list index for O(log n) positions
+    disablePositionIndex:Drop the index
+    enableValueIndex:Keep a hash index so search is sub-linear
+    disableValueIndex:Drop the hash index
+    positionOf:Turn a node index back into a position
     search:Find the position of a value
     display:Output the list
+    stats:Histograms of traversal steps (NODEPOOL_STATS builds)
+    saveRoot/loadRoot:Keep a list in a root slot of its (persistent) pool
+    exportTo:Write the list in binary to a buffer or file descriptor
+    importFrom:Replace the list with one read back by importFrom
+    relayout:Renumber the nodes so the list runs through ascending indices
+    relayoutStep:Do a bounded part of an in-place relayout
+    begin/end:Forward iterators for range-for and <algorithm>
+    before_begin:Iterator before the first element, for insert_after
+    insert_after:Insert a value after an iterator in O(1)
+    erase_after:Remove the element after an iterator in O(1)
+    insertHandle/searchHandle:Insert or find a value and get a NodeHandle
+    insertAfter/removeAfter/get:O(1) edits through a NodeHandle
+    enableConcurrentReaders:Let threads search and iterate during writes
+    ReadGuard:Keep the nodes a reader can reach from being recycled
+    remove_if:Remove every element matching a predicate in one pass
+    unique:Remove consecutive duplicates in one pass
+    reverse:Reverse the list in place in one pass
+    sort:Stable merge sort that relinks nodes instead of moving values
+    merge:Splice another sorted list of the same pool into this one
 
-  Copying and assignment are explicitly disabled to prevent shallow copies
-  and unsafe sharing of the underlying node pool.
+  Modes:
+    Copies share nodes copy-on-write within a pool.
+    Moves are O(1); emplace builds a value in its node.
+    A PositionIndex (skip list) resolves positions in O(log n).
+    A ValueIndex (hash table) makes search sub-linear.
+    Handles name nodes and go stale when their node is released or moved.
+    Concurrent readers search and iterate while one thread writes.
+    Rooted lists survive in a persistent pool (saveRoot/loadRoot).
+    NODEPOOL_STATS builds count the steps each operation takes.
 
 -------------------------------------------------------------------------*/
 
 #ifndef ARRAYBASEDLIST_H
 #define ARRAYBASEDLIST_H
 #include <string>
-#include "nodePool.h"
+#include "nodepool.h"
+#include "PositionIndex.h"
+#include "ValueIndex.h"
+#include "EpochReclaimer.h"
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <vector>
+#include <utility>
+
+/*** Progress of an incremental relayout ***/
+enum RelayoutProgress
+{
+    RELAYOUT_PENDING,// Work remains: call relayoutStep() again
+    RELAYOUT_DONE,   // The pass has finished
+    RELAYOUT_FAILED  // Refused or out of nodes (an error was printed)
+};
 
 class ArrayBasedList
 {
+    enum { BEFORE_HEAD = -2 }; // Node of before_begin()
+
 public:
+    /*** ListIterator: forward iterator over the values of a list ***/
+    template <typename Value, typename List>
+    class ListIterator
+    {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef ElementType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        ListIterator() : list(0), node(NULL_INDEX) {}
+        ListIterator(List* owner, int at) : list(owner), node(at) {}
+
+        // iterator converts to const_iterator (not the other way)
+        template <typename OtherValue, typename OtherList>
+        ListIterator(const ListIterator<OtherValue, OtherList>& other)
+            : list(other.list), node(other.node) {}
+
+        reference operator*() const { return list->pool->data(node); }
+        pointer operator->() const { return &list->pool->data(node); }
+
+        ListIterator& operator++()
+        {
+            node = (node == BEFORE_HEAD) ? list->loadHead() : list->pool->loadNext(node);
+            return *this;
+        }
+
+        ListIterator operator++(int)
+        {
+            ListIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template <typename OtherValue, typename OtherList>
+        bool operator==(const ListIterator<OtherValue, OtherList>& other) const
+        {
+            return node == other.node;
+        }
+
+        template <typename OtherValue, typename OtherList>
+        bool operator!=(const ListIterator<OtherValue, OtherList>& other) const
+        {
+            return node != other.node;
+        }
+
+        int nodeIndex() const { return node; } // Pool index of the element
+
+    private:
+        template <typename, typename> friend class ListIterator;
+        friend class ArrayBasedList;
+
+        List* list; // List iterated over
+        int node;   // Current node, NULL_INDEX at end(), BEFORE_HEAD before begin()
+    };
+
+    typedef ListIterator<ElementType, ArrayBasedList> iterator;
+    typedef ListIterator<const ElementType, const ArrayBasedList> const_iterator;
+
+    /*** ReadGuard: read-side critical section of a concurrent reader ***/
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const ArrayBasedList& list);
+        ~ReadGuard();
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        EpochReclaimer* epochs; // Epochs of the list, 0 without concurrent readers
+        int slot;               // Reader slot held in epochs
+    };
+
     /******** Function Members ********/
 
     ArrayBasedList(NodePool* externalPool);
@@ -42,7 +170,8 @@ public:
      Destroy the list and return all nodes to the free list.
 
      Precondition:  None
-     Postcondition: All nodes in the list are released to the NodePool.
+     Postcondition: All nodes in the list are released to the NodePool,
+                    unless the list is rooted (see saveRoot).
     -----------------------------------------------------------------------*/
 
     bool empty() const;
@@ -61,6 +190,32 @@ public:
      Postcondition: value is inserted at position; list is updated.
     -----------------------------------------------------------------------*/
 
+    bool insert(ElementType&& value, int position);
+    /*----------------------------------------------------------------------
+     Insert a value at a given position, moving it into the node.
+
+     Precondition:  0 <= position <= current list length; node pool has space.
+     Postcondition: As insert(const ElementType&, int); value is left
+                    valid but unspecified on success.
+    -----------------------------------------------------------------------*/
+
+    template <typename... Args>
+    bool emplace(int position, Args&&... args);
+    /*----------------------------------------------------------------------
+     Insert ElementType(args...) at a given position, constructed directly
+     in the node's slot.
+
+     Precondition:  0 <= position <= current list length; node pool has space.
+     Postcondition: As insert(); if the constructor throws, the node goes
+                    back to the pool and the list is unchanged.
+    -----------------------------------------------------------------------*/
+
+    template <typename... Args>
+    bool emplace_back(Args&&... args);
+    /*----------------------------------------------------------------------
+     Append ElementType(args...) constructed in place; emplace(length(), args...).
+    -----------------------------------------------------------------------*/
+
     bool remove(int position);
     /*----------------------------------------------------------------------
      Remove the node at a given position.
@@ -69,6 +224,60 @@ public:
      Postcondition: Node is removed and returned to the NodePool.
     -----------------------------------------------------------------------*/
 
+    bool push_back(const ElementType& value);
+    /*----------------------------------------------------------------------
+     Append a value at the end of the list in O(1).
+
+     Precondition:  node pool has space.
+     Postcondition: value is the last element; same as insert(value, length()).
+    -----------------------------------------------------------------------*/
+
+    bool push_back(ElementType&& value);
+    /*----------------------------------------------------------------------
+     Append a value, moving it into the node.
+    -----------------------------------------------------------------------*/
+
+    bool push_front(const ElementType& value);
+    /*----------------------------------------------------------------------
+     Insert a value at the front of the list in O(1).
+
+     Precondition:  node pool has space.
+     Postcondition: value is the first element; same as insert(value, 0).
+    -----------------------------------------------------------------------*/
+
+    bool push_front(ElementType&& value);
+    /*----------------------------------------------------------------------
+     Prepend a value, moving it into the node.
+    -----------------------------------------------------------------------*/
+
+    bool pop_front();
+    /*----------------------------------------------------------------------
+     Remove the first element of the list in O(1).
+
+     Precondition:  List is not empty.
+     Postcondition: First node is returned to the NodePool; same as remove(0).
+    -----------------------------------------------------------------------*/
+
+    bool insertRange(const vector<ElementType>& items, int position);
+    /*----------------------------------------------------------------------
+     Insert several values, in order, starting at a given position.
+
+     Precondition:  0 <= position <= current list length.
+     Postcondition: items occupy positions position..position+size-1.
+                    Nothing is inserted if the pool cannot hold them all.
+    -----------------------------------------------------------------------*/
+
+    bool assign(const vector<ElementType>& items);
+    bool assign(const ElementType* items, size_t count);
+    /*----------------------------------------------------------------------
+     Replace the contents of the list with items (the first count of
+     them, for a slice of a larger array).
+
+     Precondition:  None
+     Postcondition: The list holds exactly items; on failure (pool
+                    exhausted) it is left unchanged.
+    -----------------------------------------------------------------------*/
+
     int search(const ElementType& value) const;
     /*----------------------------------------------------------------------
      Search for a value in the list.
@@ -101,6 +310,372 @@ public:
       Postcondition: List is empty and all nodes are released.
     -----------------------------------------------------------------------*/
 
+    void enablePositionIndex();
+    /*----------------------------------------------------------------------
+      Build a PositionIndex over the list and keep it up to date.
+
+      Precondition:  None
+      Postcondition: insert/remove resolve positions in O(log n) expected.
+    -----------------------------------------------------------------------*/
+
+    void disablePositionIndex();
+    /*----------------------------------------------------------------------
+      Drop the PositionIndex, if any.
+
+      Precondition:  None
+      Postcondition: Positions are resolved by walking from head or finger.
+    -----------------------------------------------------------------------*/
+
+    bool hasPositionIndex() const;
+    /*----------------------------------------------------------------------
+      Check whether a PositionIndex is kept.
+
+      Precondition:  None
+      Postcondition: Returns true if enablePositionIndex() is in effect.
+    -----------------------------------------------------------------------*/
+
+    void enableValueIndex();
+    /*----------------------------------------------------------------------
+      Build a ValueIndex over the list and keep it up to date.
+
+      Precondition:  None
+      Postcondition: search() probes a hash table instead of scanning.
+    -----------------------------------------------------------------------*/
+
+    void disableValueIndex();
+    /*----------------------------------------------------------------------
+      Drop the ValueIndex, if any.
+
+      Precondition:  None
+      Postcondition: search() scans the list.
+    -----------------------------------------------------------------------*/
+
+    bool hasValueIndex() const;
+    /*----------------------------------------------------------------------
+      Check whether a ValueIndex is kept.
+
+      Precondition:  None
+      Postcondition: Returns true if enableValueIndex() is in effect.
+    -----------------------------------------------------------------------*/
+
+    bool enableConcurrentReaders();
+    /*----------------------------------------------------------------------
+      Let other threads search and iterate the list while this thread
+      (the only writer) changes it.
+
+      Precondition:  No other thread uses the list yet.
+      Postcondition: Returns false (with an error) if the list shares
+                     nodes and the pool cannot supply copies. Readers may
+                     stay through insert, emplace, remove, push_back,
+                     push_front, pop_front, insertRange, insert_after,
+                     erase_after, remove_if, unique, clear and assign;
+                     sort, merge, reverse and relayout refuse with an
+                     error, and anything else that changes the list
+                     object needs the readers gone.
+    -----------------------------------------------------------------------*/
+
+    void disableConcurrentReaders();
+    /*----------------------------------------------------------------------
+      Return to single-threaded use.
+
+      Precondition:  No reader is inside a ReadGuard or search().
+      Postcondition: Every retired node is released to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool hasConcurrentReaders() const;
+    /*----------------------------------------------------------------------
+      Check whether enableConcurrentReaders() is in effect.
+
+      Precondition:  None
+      Postcondition: Returns true in concurrent reader mode.
+    -----------------------------------------------------------------------*/
+
+    int positionOf(int node) const;
+    /*----------------------------------------------------------------------
+      Return the position of a node of this list.
+
+      Precondition:  node is the index of a node in this list.
+      Postcondition: Returns its position; O(log n) expected with a
+                     PositionIndex, a link-only walk from head without.
+    -----------------------------------------------------------------------*/
+
+    bool saveRoot(int slot);
+    /*----------------------------------------------------------------------
+      Record the list's head, tail and length in a root slot of its pool,
+      so a persistent pool remembers the list after sync(). Call it again
+      before each sync() if the list changed since.
+
+      Precondition:  0 <= slot < POOL_ROOTS
+      Postcondition: Returns false for a bad slot. The list is now rooted:
+                     when destroyed it records its final chain in the slot
+                     instead of releasing its nodes.
+    -----------------------------------------------------------------------*/
+
+    bool loadRoot(int slot);
+    /*----------------------------------------------------------------------
+      Adopt the chain recorded in a root slot, typically after reopening a
+      persistent pool. No node is copied; kept indexes are rebuilt.
+
+      Precondition:  The list is empty.
+      Postcondition: Returns false (list unchanged) for a bad slot, a
+                     non-empty list or a root that does not fit the pool.
+                     Otherwise the list is rooted in slot, as by saveRoot.
+    -----------------------------------------------------------------------*/
+
+    size_t serializedSize() const;
+    /*----------------------------------------------------------------------
+      Return the number of bytes exportTo() writes for this list.
+
+      Precondition:  None
+      Postcondition: Header plus every encoded element.
+    -----------------------------------------------------------------------*/
+
+    size_t exportTo(char* buffer, size_t capacity) const;
+    /*----------------------------------------------------------------------
+      Write the list into a caller-supplied buffer: a 24-byte header
+      (magic "ABLS", version, element count, payload bytes), then each
+      element as a 4-byte length and its characters, in native byte order.
+
+      Precondition:  buffer holds at least capacity bytes.
+      Postcondition: Returns the bytes written (serializedSize()), or 0 if
+                     capacity is too small, in which case nothing is written.
+    -----------------------------------------------------------------------*/
+
+    bool exportTo(int fd) const;
+    /*----------------------------------------------------------------------
+      Write the list to a file descriptor (file, pipe or socket).
+
+      Precondition:  fd is open for writing.
+      Postcondition: Returns false if a write fails; the bytes already
+                     written then form an incomplete list.
+    -----------------------------------------------------------------------*/
+
+    size_t importFrom(const char* buffer, size_t length);
+    /*----------------------------------------------------------------------
+      Replace the contents with a list written by exportTo(buffer).
+
+      Precondition:  buffer holds length bytes.
+      Postcondition: Returns the bytes consumed (one list; more may follow).
+                     Returns 0 and leaves the list unchanged if the data is
+                     malformed or truncated or the pool cannot hold it.
+    -----------------------------------------------------------------------*/
+
+    bool importFrom(int fd);
+    /*----------------------------------------------------------------------
+      Replace the contents with a list read from a file descriptor.
+
+      Precondition:  fd is open for reading.
+      Postcondition: Reads exactly one list's bytes. Returns false and
+                     leaves the list unchanged on a read error, early end
+                     of data, malformed data or pool exhaustion.
+    -----------------------------------------------------------------------*/
+
+    bool relayout();
+    /*----------------------------------------------------------------------
+      Renumber the list's nodes so that its order matches ascending index
+      order, packed into the lowest indices it can use. O(pool capacity).
+
+      Precondition:  The pool is single-threaded and nothing else holds
+                     indices of this list's nodes.
+      Postcondition: Returns false (list unchanged) for a concurrent pool.
+                     Otherwise the list, its indexes and the free list
+                     (now ascending) are updated.
+    -----------------------------------------------------------------------*/
+
+    RelayoutProgress relayoutStep(size_t budget);
+    /*----------------------------------------------------------------------
+      Advance an incremental relayout by about budget nodes of work.
+      Every other change to the list, including taking copies of shared
+      nodes, cancels the pass in progress, so a pass only finishes when
+      no change comes between its steps.
+
+      Precondition:  Nothing else holds indices of this list's nodes.
+      Postcondition: Returns RELAYOUT_DONE once the list's order matches
+                     ascending index order within the nodes it occupies (a
+                     pass has finished or there was nothing to do), and
+                     RELAYOUT_PENDING while work remains. Returns
+                     RELAYOUT_FAILED (with an error) with concurrent
+                     readers or when the pool cannot supply copies of
+                     shared nodes. The list is valid between calls.
+    -----------------------------------------------------------------------*/
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    /*----------------------------------------------------------------------
+      Iterators over the elements in list order. The mutable begin()
+      first copies any nodes shared with copies of the list.
+
+      Precondition:  None
+      Postcondition: begin() == end() for an empty list, and the mutable
+                     begin() is end() (with an error) if the pool cannot
+                     supply those copies.
+    -----------------------------------------------------------------------*/
+
+    iterator before_begin();
+    const_iterator before_begin() const;
+    /*----------------------------------------------------------------------
+      Iterator that precedes the first element; incrementing it gives
+      begin(). It may not be dereferenced.
+
+      Precondition:  None
+      Postcondition: insert_after(before_begin(), v) inserts at the front;
+                     the mutable one is end() like begin() on failure.
+    -----------------------------------------------------------------------*/
+
+    iterator insert_after(const_iterator position, const ElementType& value);
+    /*----------------------------------------------------------------------
+      Insert a value right after an iterator.
+
+      Precondition:  position is before_begin() or an element of the list;
+                     node pool has space.
+      Postcondition: Returns an iterator to the new element, or end() (with
+                     an error) if the pool is exhausted.
+    -----------------------------------------------------------------------*/
+
+    iterator erase_after(const_iterator position);
+    /*----------------------------------------------------------------------
+      Remove the element right after an iterator.
+
+      Precondition:  position is before_begin() or an element of the list
+                     that has a successor.
+      Postcondition: The node is returned to the pool; returns an iterator
+                     to the element that followed it (end() if none).
+    -----------------------------------------------------------------------*/
+
+    NodeHandle insertHandle(const ElementType& value, int position);
+    /*----------------------------------------------------------------------
+      Insert a value at a given position and return a handle to it.
+
+      Precondition:  0 <= position <= current list length; node pool has
+                     space.
+      Postcondition: Returns the new element's handle, or a null handle
+                     (with an error) if the insert failed.
+    -----------------------------------------------------------------------*/
+
+    NodeHandle searchHandle(const ElementType& value);
+    /*----------------------------------------------------------------------
+      Find the first element equal to value, as search() does.
+
+      Precondition:  None
+      Postcondition: Returns its handle, or a null handle if not found.
+    -----------------------------------------------------------------------*/
+
+    NodeHandle insertAfter(NodeHandle handle, const ElementType& value);
+    /*----------------------------------------------------------------------
+      Insert a value right after the element of a handle (at the front
+      for a null handle) in O(1).
+
+      Precondition:  handle is null or names an element of this list.
+      Postcondition: Returns the new element's handle; a null handle (with
+                     an error) for a stale handle or an exhausted pool.
+    -----------------------------------------------------------------------*/
+
+    bool removeAfter(NodeHandle handle);
+    /*----------------------------------------------------------------------
+      Remove the element right after the element of a handle (the first
+      element for a null handle) in O(1).
+
+      Precondition:  handle is null or names an element of this list.
+      Postcondition: Returns false (with an error) for a stale handle or
+                     when there is no element to remove. Handles to the
+                     removed element go stale.
+    -----------------------------------------------------------------------*/
+
+    ElementType* get(NodeHandle handle);
+    const ElementType* get(NodeHandle handle) const;
+    /*----------------------------------------------------------------------
+      Access the value of a handle's element in O(1).
+
+      Precondition:  handle names an element of this list.
+      Postcondition: Returns a pointer to the value, or 0 (with an error)
+                     for a null or stale handle. As for iterators, call
+                     enableValueIndex() again after writing values.
+    -----------------------------------------------------------------------*/
+
+    bool isValid(NodeHandle handle) const;
+    /*----------------------------------------------------------------------
+      Check whether a handle still names a live node.
+
+      Precondition:  None
+      Postcondition: Returns false for null and stale handles.
+    -----------------------------------------------------------------------*/
+
+    template <typename Predicate>
+    size_t remove_if(Predicate matches);
+    /*----------------------------------------------------------------------
+      Remove every element for which matches(value) is true.
+
+      Precondition:  None
+      Postcondition: Returns the number removed. The list is walked once
+                     and the removed nodes go back to the pool as a chain.
+    -----------------------------------------------------------------------*/
+
+    size_t unique();
+    /*----------------------------------------------------------------------
+      Remove each element equal to the one before it.
+
+      Precondition:  None
+      Postcondition: No two neighbours are equal; returns the number
+                     removed, in one pass.
+    -----------------------------------------------------------------------*/
+
+    void reverse();
+    /*----------------------------------------------------------------------
+      Reverse the order of the elements by relinking the nodes.
+
+      Precondition:  None
+      Postcondition: The first element is last and so on; no value moves.
+    -----------------------------------------------------------------------*/
+
+    bool sort();
+    template <typename Compare>
+    bool sort(Compare less);
+    /*----------------------------------------------------------------------
+      Sort the elements by operator< or by less(a, b), stably, by
+      relinking the nodes.
+
+      Precondition:  less is a strict weak ordering.
+      Postcondition: Returns false (list unchanged) only if the pool runs
+                     out while the list takes its own copies of shared
+                     nodes. No value is copied.
+    -----------------------------------------------------------------------*/
+
+    bool merge(ArrayBasedList& other);
+    template <typename Compare>
+    bool merge(ArrayBasedList& other, Compare less);
+    /*----------------------------------------------------------------------
+      Move every element of other into this list, keeping it sorted.
+
+      Precondition:  Both lists are sorted by less (or operator<).
+      Postcondition: Returns false (with an error, nothing moved) if other
+                     uses a different pool or the pool runs out while
+                     taking copies of shared nodes. Otherwise this list
+                     holds both lists' elements in sorted order, equal
+                     elements of this list first, and other is empty.
+                     O(length() + other.length()); no value is copied.
+    -----------------------------------------------------------------------*/
+
+    ListStats stats() const;
+    /*----------------------------------------------------------------------
+      Take a snapshot of the step histograms; safe from any thread.
+
+      Precondition:  None
+      Postcondition: Returns the histograms (all zero unless built with
+                     NODEPOOL_STATS).
+    -----------------------------------------------------------------------*/
+
+    void resetStats();
+    /*----------------------------------------------------------------------
+      Clear the step histograms.
+
+      Precondition:  None
+      Postcondition: Every bucket is 0.
+    -----------------------------------------------------------------------*/
+
     int getHead() const;
     /*----------------------------------------------------------------------
       Get the index of the head node.
@@ -115,7 +690,9 @@ public:
      Copy constructor.
 
      Precondition:  None
-     Postcondition: A new list is created with the same contents as source.
+     Postcondition: A new list is created with the same contents as source,
+                    sharing its nodes until either list changes; it keeps
+                    a PositionIndex / ValueIndex if source does.
     -----------------------------------------------------------------------*/
 
     ArrayBasedList& operator=(const ArrayBasedList&);
@@ -123,16 +700,469 @@ public:
      Assignment operator.
 
      Precondition:  None
-     Postcondition: The current list is cleared and replaced with a copy of source.
+     Postcondition: The current list is cleared and replaced with a copy of source
+                    (shared copy-on-write within one pool, deep otherwise).
+                    Whether the list keeps its indexes is unchanged; a
+                    rooted list stays rooted in its slot, which is saved
+                    again for the new chain.
+    -----------------------------------------------------------------------*/
+
+    /***** Move constructor *****/
+    ArrayBasedList(ArrayBasedList&& source) noexcept;
+    /*----------------------------------------------------------------------
+     Move constructor; O(1).
+
+     Precondition:  None
+     Postcondition: The new list holds source's nodes, indexes and root
+                    slot; source is empty, unrooted and keeps no indexes.
+    -----------------------------------------------------------------------*/
+
+    ArrayBasedList& operator=(ArrayBasedList&& source);
+    /*----------------------------------------------------------------------
+     Move assignment.
+
+     Precondition:  None
+     Postcondition: The current nodes are released and source's nodes and
+                    indexes taken over in O(1), leaving source as after a
+                    move construction. Lists on different pools cannot
+                    share nodes: then this copies, as operator=(const&).
+                    A rooted list keeps its slot, saved again for the
+                    new chain; otherwise it takes over source's slot.
     -----------------------------------------------------------------------*/
 
 private:
+    int acquireFor(int position);
+    /*----------------------------------------------------------------------
+      Check an insert position and take a node for it.
+
+      Precondition:  None
+      Postcondition: Returns the new node, or NULL_INDEX (with an error)
+                     for a bad position or an exhausted pool.
+    -----------------------------------------------------------------------*/
+
+    void linkNewNode(int newIndex, int position);
+    /*----------------------------------------------------------------------
+      Link a node whose data is already set in at a position.
+
+      Precondition:  newIndex came from acquireFor(position).
+      Postcondition: The node is at position; indexes, finger and tail are
+                     updated.
+    -----------------------------------------------------------------------*/
+
+    void releaseAll();
+    /*----------------------------------------------------------------------
+      Return every node to the pool as one chain.
+
+      Precondition:  None
+      Postcondition: head/tail are NULL_INDEX and mySize is 0; the
+                     indexes are left for the caller to clear or rebuild.
+    -----------------------------------------------------------------------*/
+
+    void shareNodes(const ArrayBasedList& source);
+    /*----------------------------------------------------------------------
+      Make an empty list share source's chain copy-on-write.
+
+      Precondition:  The list is empty; source uses the same pool.
+      Postcondition: Both lists hold the chain and count all of it as
+                     possibly shared; indexes are rebuilt.
+    -----------------------------------------------------------------------*/
+
+    bool privatize(int count);
+    bool privatize(int count, int& watch);
+    /*----------------------------------------------------------------------
+      Replace each shared node among the first count positions with a
+      node of this list's own, so those nodes (and the links out of them)
+      may be changed.
+
+      Precondition:  0 <= count <= length()
+      Postcondition: Returns false (with an error) if the pool runs out;
+                     the positions done so far stay private. If watch is
+                     given and its node was replaced, it names the copy.
+    -----------------------------------------------------------------------*/
+
+    int loadHead() const;
+    void publishHead(int node);
+    /*----------------------------------------------------------------------
+      Read head with acquire and write it with release ordering, as
+      NodePool::loadNext and publishNext do for links.
+    -----------------------------------------------------------------------*/
+
+    void releaseRemoved(int node);
+    /*----------------------------------------------------------------------
+      Give back a node that was unlinked from the list: to the pool at
+      once, or to the EpochReclaimer while there are concurrent readers.
+    -----------------------------------------------------------------------*/
+
+    bool refuseWithReaders(const char* operation) const;
+    /*----------------------------------------------------------------------
+      Return true (with an error naming operation) in concurrent reader
+      mode, for operations that rewrite links in place.
+    -----------------------------------------------------------------------*/
+
+    bool mayShareWith(const ArrayBasedList& source) const;
+    /*----------------------------------------------------------------------
+      Check whether a copy of source may share its chain copy-on-write:
+      same pool, and neither handles nor concurrent readers involved.
+    -----------------------------------------------------------------------*/
+
+    int concurrentSearch(const ElementType& value) const;
+    /*----------------------------------------------------------------------
+      search() for concurrent reader mode: walk the list inside a
+      ReadGuard with acquire loads.
+    -----------------------------------------------------------------------*/
+
+    NodeHandle issueHandle(int node);
+    /*----------------------------------------------------------------------
+      Make a handle to one of the list's nodes.
+
+      Precondition:  The list shares no nodes.
+      Postcondition: Copies of the list no longer share its chain.
+    -----------------------------------------------------------------------*/
+
+    void copyNodes(const ArrayBasedList& source);
+    /*----------------------------------------------------------------------
+      Fill an empty list with copies of source's nodes.
+
+      Precondition:  The list is empty.
+      Postcondition: The list equals source (empty on pool exhaustion) and
+                     its indexes are rebuilt.
+    -----------------------------------------------------------------------*/
+
+    void rebuildIndexes();
+    /*----------------------------------------------------------------------
+      Rebuild whichever indexes are kept from the current nodes.
+    -----------------------------------------------------------------------*/
+
+    int indexedSearch(const ElementType& value) const;
+    /*----------------------------------------------------------------------
+      search() through the ValueIndex; among duplicates the node with the
+      lowest position wins.
+
+      Precondition:  values != 0
+      Postcondition: Returns the same result as a full scan.
+    -----------------------------------------------------------------------*/
+
+    int nodeAt(int position);
+    /*----------------------------------------------------------------------
+      Resolve a position to a node index, starting from the finger when it
+      is at or before position and from head otherwise.
+
+      Precondition:  0 <= position < current list length.
+      Postcondition: Returns the node index; the finger is moved there.
+    -----------------------------------------------------------------------*/
+
+    void unlinkAfter(int prev, int node, int& first, int& last);
+    /*----------------------------------------------------------------------
+      Unlink node (which follows prev, or is head when prev is
+      NULL_INDEX) and append it to the chain first..last of removed nodes.
+
+      Precondition:  A single-pass removal (remove_if, unique) is running.
+      Postcondition: head, tail and mySize are updated; the ValueIndex
+                     no longer holds node. The PositionIndex is not
+                     touched.
+    -----------------------------------------------------------------------*/
+
+    void finishRemoval(int first, int last, size_t count);
+    /*----------------------------------------------------------------------
+      End a single-pass removal: release the removed chain and rebuild
+      the PositionIndex.
+    -----------------------------------------------------------------------*/
+
+    template <typename Compare>
+    int mergeChains(int first, int firstLast, int second, int secondLast,
+                    Compare& less, int& last);
+    /*----------------------------------------------------------------------
+      Merge two sorted chains ending in NULL_INDEX by relinking them.
+
+      Precondition:  Both chains are sorted by less; either may be empty
+                     (NULL_INDEX). firstLast and secondLast are their tails.
+      Postcondition: Returns the head of the merged chain (ties taken from
+                     first) and sets last to its final node.
+    -----------------------------------------------------------------------*/
+
+    void finishRelink();
+    /*----------------------------------------------------------------------
+      End an operation that reordered the nodes: forget the finger and
+      rebuild the PositionIndex.
+    -----------------------------------------------------------------------*/
+
+    void cancelRelayout();
+    /*----------------------------------------------------------------------
+      Abandon the incremental relayout in progress, if any; called by
+      every operation that changes the list.
+    -----------------------------------------------------------------------*/
+
+    void swapPositions(int first, int second);
+    /*----------------------------------------------------------------------
+      Exchange the nodes holding two positions during relayoutStep().
+
+      Precondition:  A relayout pass has collected the whole list.
+      Postcondition: The payloads swapped nodes and the links, indexes
+                     and pass bookkeeping around both were fixed up.
+    -----------------------------------------------------------------------*/
+
+    static bool readStreamHeader(const char* header, size_t available, size_t& count, size_t& bytes);
+    /*----------------------------------------------------------------------
+      Validate a stream header and read its element and byte counts.
+
+      Precondition:  header points to at least available bytes.
+      Postcondition: Returns false (with a message) for a short or foreign
+                     header or counts this list cannot hold.
+    -----------------------------------------------------------------------*/
+
+    void adoptChain(int first, int last, size_t count);
+    /*----------------------------------------------------------------------
+      Replace the contents with a filled chain taken from the pool.
+
+      Precondition:  first..last is a chain of count nodes, or NULL_INDEX.
+      Postcondition: Old nodes are released and the indexes rebuilt.
+    -----------------------------------------------------------------------*/
+
+    enum { FINGER_REACH = 16 }; // Finger distance preferred over the index
+    enum { STREAM_BLOCK = 1 << 16 }; // Bytes per read/write on a descriptor
+
     /******** Data Members ********/
 
     int head; // Index of first node in the list
+    int tail; // Index of last node in the list
     NodePool* pool; // Pointer to external node pool
     int mySize; // Size of the array
+    int fingerPos; // Position of the last resolved node, -1 if none
+    int fingerIndex; // Node index at fingerPos
+    PositionIndex* index; // Optional skip list over positions, or 0
+    ValueIndex* values; // Optional hash index over values, or 0
+    int rootSlot; // Pool root slot the list is kept in, -1 if none
+    struct RelayoutPass;
+    RelayoutPass* relayoutPass; // Incremental relayout in progress, or 0
+    mutable int sharedTail; // Trailing nodes that may be shared with copies
+    bool handlesOut; // Handles were issued: the chain is never shared
+    EpochReclaimer* epochs; // Concurrent reader epochs, or 0
+#ifdef NODEPOOL_STATS
+    mutable size_t stepsTaken; // Steps of the operation in progress
+    StepRecorder insertSteps;
+    StepRecorder removeSteps;
+    mutable StepRecorder searchSteps;
+#endif
 
 };
 
+/* -----------------------------
+   remove_if()
+   Purpose: Remove every element matching a predicate in one pass.
+   Input: matches (predicate on ElementType)
+   Output: Number of elements removed
+   ----------------------------- */
+template <typename Predicate>
+size_t ArrayBasedList::remove_if(Predicate matches)
+{
+    if (!privatize(mySize)) {
+        return 0;
+    }
+    int first = NULL_INDEX, last = NULL_INDEX;
+    size_t removed = 0;
+    int prev = NULL_INDEX;
+    int current = head;
+    while (current != NULL_INDEX) {
+        int following = pool->next(current);
+        if (matches(pool->data(current))) {
+            unlinkAfter(prev, current, first, last);
+            removed++;
+        }
+        else {
+            prev = current;
+        }
+        current = following;
+    }
+    finishRemoval(first, last, removed);
+    return removed;
+}
+
+/* -----------------------------
+   sort()
+   Purpose: Stable bottom-up merge sort by relinking nodes.
+   Input: less (comparator on ElementType)
+   Output: true unless copying shared nodes failed
+   ----------------------------- */
+template <typename Compare>
+bool ArrayBasedList::sort(Compare less)
+{
+    if (refuseWithReaders("sort")) {
+        return false;
+    }
+    if (mySize < 2) {
+        return true;
+    }
+    if (!privatize(mySize)) {
+        return false;
+    }
+    cancelRelayout();
+
+    // runs[k] holds 2^k sorted nodes (or none); higher runs came earlier
+    enum { MAX_RUNS = 64 };
+    int runs[MAX_RUNS];
+    int runTails[MAX_RUNS];
+    int filled = 0;
+    int current = head;
+    while (current != NULL_INDEX) {
+        int carry = current;
+        int carryLast = current;
+        current = pool->next(current);
+        pool->next(carry) = NULL_INDEX;
+
+        int k = 0;
+        for (; k < filled && runs[k] != NULL_INDEX; k++) {
+            carry = mergeChains(runs[k], runTails[k], carry, carryLast, less, carryLast);
+            runs[k] = NULL_INDEX;
+        }
+        runs[k] = carry;
+        runTails[k] = carryLast;
+        if (k == filled) {
+            filled++;
+        }
+    }
+
+    int sorted = NULL_INDEX;
+    int sortedLast = NULL_INDEX;
+    for (int k = 0; k < filled; k++) {
+        if (runs[k] != NULL_INDEX) {
+            sorted = mergeChains(runs[k], runTails[k], sorted, sortedLast, less, sortedLast);
+        }
+    }
+    head = sorted;
+    tail = sortedLast;
+    finishRelink();
+    return true;
+}
+
+/* -----------------------------
+   merge()
+   Purpose: Splice another sorted list of the same pool into this one.
+   Input: other (ArrayBasedList), less (comparator on ElementType)
+   Output: true if merged; other is empty
+   ----------------------------- */
+template <typename Compare>
+bool ArrayBasedList::merge(ArrayBasedList& other, Compare less)
+{
+    if (&other == this || other.head == NULL_INDEX) {
+        return true;
+    }
+    if (other.pool != pool) {
+        cerr << "Error: Cannot merge lists of different pools" << endl;
+        return false;
+    }
+    if (refuseWithReaders("merge") || other.refuseWithReaders("merge")) {
+        return false;
+    }
+    if (!privatize(mySize) || !other.privatize(other.mySize)) {
+        return false;
+    }
+    cancelRelayout();
+    other.cancelRelayout();
+
+    if (values != 0) {
+        for (int current = other.head; current != NULL_INDEX; current = pool->next(current)) {
+            values->insert(current);
+        }
+    }
+    if (other.values != 0) {
+        other.values->clear();
+    }
+    if (other.index != 0) {
+        other.index->clear();
+    }
+
+    head = mergeChains(head, tail, other.head, other.tail, less, tail);
+    mySize += other.mySize;
+    other.head = NULL_INDEX;
+    other.tail = NULL_INDEX;
+    other.mySize = 0;
+    other.fingerPos = -1;
+    finishRelink();
+    return true;
+}
+
+/* -----------------------------
+   mergeChains()
+   Purpose: Merge two sorted NULL_INDEX-terminated chains.
+   Input: first, second and their tails (int), less (comparator)
+   Output: Head of the merged chain; last set to its tail
+   ----------------------------- */
+template <typename Compare>
+int ArrayBasedList::mergeChains(int first, int firstLast, int second, int secondLast,
+                                Compare& less, int& last)
+{
+    if (first == NULL_INDEX || second == NULL_INDEX) {
+        last = (first == NULL_INDEX) ? secondLast : firstLast;
+        return (first == NULL_INDEX) ? second : first;
+    }
+
+    int merged = NULL_INDEX;
+    int linked = NULL_INDEX; // Last node placed so far
+    while (first != NULL_INDEX && second != NULL_INDEX) {
+        int taken;
+        if (less(pool->data(second), pool->data(first))) {
+            taken = second; // Strictly smaller: equal elements keep first's order
+            second = pool->next(second);
+        }
+        else {
+            taken = first;
+            first = pool->next(first);
+        }
+        if (linked == NULL_INDEX) {
+            merged = taken;
+        }
+        else {
+            pool->next(linked) = taken;
+        }
+        linked = taken;
+    }
+
+    // One chain is used up; the rest of the other follows unchanged
+    if (first != NULL_INDEX) {
+        pool->next(linked) = first;
+        last = firstLast;
+    }
+    else {
+        pool->next(linked) = second;
+        last = second != NULL_INDEX ? secondLast : linked;
+    }
+    return merged;
+}
+
+/* -----------------------------
+   emplace()
+   Purpose: Insert a value built in its node's slot.
+   Input: position (int), constructor arguments
+   Output: true if successful, false otherwise
+   ----------------------------- */
+template <typename... Args>
+bool ArrayBasedList::emplace(int position, Args&&... args)
+{
+    int newIndex = acquireFor(position);
+    if (newIndex == NULL_INDEX) {
+        return false;
+    }
+    try {
+        pool->emplace(newIndex, std::forward<Args>(args)...);
+    }
+    catch (...) {
+        pool->releaseNode(newIndex);
+        throw;
+    }
+    linkNewNode(newIndex, position);
+    return true;
+}
+
+/* -----------------------------
+   emplace_back()
+   Purpose: Append a value built in its node's slot.
+   Input: constructor arguments
+   Output: true if successful, false otherwise
+   ----------------------------- */
+template <typename... Args>
+bool ArrayBasedList::emplace_back(Args&&... args)
+{
+    return emplace(mySize, std::forward<Args>(args)...);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,595 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: DoublyLinkedList Implementation
+ *
+ * Description:
+ * This file implements a doubly linked list on a DoublyNodePool. Each
+ * node links to its successor (next) and predecessor (prev), so both ends
+ * and any node reached through an iterator can be changed in O(1).
+ */
+
+#include "DoublyLinkedList.h"
+#include <iostream>
+#include <utility>
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Initialize an empty list with a given external node pool.
+   Input: externalPool (pointer to DoublyNodePool)
+   Output: A new empty list
+   ----------------------------- */
+DoublyLinkedList::DoublyLinkedList(DoublyNodePool* externalPool)
+{
+    pool = externalPool;       // Node pool used for memory management
+    head = NULL_INDEX;         // Head index starts as null
+    tail = NULL_INDEX;         // Tail index starts as null
+    mySize = 0;                // Start with empty list
+}
+
+/* -----------------------------
+   Destructor
+   Purpose: Release all nodes back to the pool.
+   Input: None
+   Output: Frees all nodes
+   ----------------------------- */
+DoublyLinkedList::~DoublyLinkedList()
+{
+    clear();
+}
+
+/* -----------------------------
+   empty()
+   Purpose: Check if the list is empty.
+   Input: None
+   Output: true if empty, false otherwise
+   ----------------------------- */
+bool DoublyLinkedList::empty() const
+{
+    return head == NULL_INDEX;
+}
+
+/* -----------------------------
+   length()
+   Purpose: Return the number of elements in the list.
+   Input: None
+   Output: Count of nodes in the list
+   ----------------------------- */
+int DoublyLinkedList::length() const
+{
+    return mySize;
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Return the whole chain of nodes to the pool at once.
+   Input: None
+   Output: List becomes empty
+   ----------------------------- */
+void DoublyLinkedList::clear()
+{
+    if (head != NULL_INDEX) {
+        pool->releaseChain(head, tail, mySize); // Linked through next as well
+    }
+    head = NULL_INDEX;
+    tail = NULL_INDEX;
+    mySize = 0;
+}
+
+/* -----------------------------
+   acquire()
+   Purpose: Take a node from the pool for an insert.
+   Input: None
+   Output: Node index, or NULL_INDEX if the pool is exhausted
+   ----------------------------- */
+int DoublyLinkedList::acquire()
+{
+    int node = pool->acquireNode();
+    if (node == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+    }
+    return node;
+}
+
+/* -----------------------------
+   linkBefore()
+   Purpose: Link a filled node in front of successor.
+   Input: node (int), successor (int, NULL_INDEX to append)
+   Output: List grows by one
+   ----------------------------- */
+void DoublyLinkedList::linkBefore(int node, int successor)
+{
+    int predecessor = (successor == NULL_INDEX) ? tail : pool->prev(successor);
+    pool->next(node) = successor;
+    pool->prev(node) = predecessor;
+
+    if (predecessor == NULL_INDEX) {
+        head = node;
+    }
+    else {
+        pool->next(predecessor) = node;
+    }
+    if (successor == NULL_INDEX) {
+        tail = node;
+    }
+    else {
+        pool->prev(successor) = node;
+    }
+    mySize++;
+}
+
+/* -----------------------------
+   unlink()
+   Purpose: Remove one node given its index.
+   Input: node (int)
+   Output: The node that followed it
+   ----------------------------- */
+int DoublyLinkedList::unlink(int node)
+{
+    int predecessor = pool->prev(node);
+    int successor = pool->next(node);
+
+    if (predecessor == NULL_INDEX) {
+        head = successor;
+    }
+    else {
+        pool->next(predecessor) = successor;
+    }
+    if (successor == NULL_INDEX) {
+        tail = predecessor;
+    }
+    else {
+        pool->prev(successor) = predecessor;
+    }
+    pool->releaseNode(node);
+    mySize--;
+    return successor;
+}
+
+/* -----------------------------
+   nodeAt()
+   Purpose: Find the node at a position from the nearer end.
+   Input: position (int)
+   Output: Node index
+   ----------------------------- */
+int DoublyLinkedList::nodeAt(int position) const
+{
+    if (position <= mySize / 2) {
+        int current = head;
+        for (int i = 0; i < position; i++) {
+            current = pool->next(current);
+        }
+        return current;
+    }
+    int current = tail;
+    for (int i = mySize - 1; i > position; i--) {
+        current = pool->prev(current);
+    }
+    return current;
+}
+
+/* -----------------------------
+   insert()
+   Purpose: Insert a value at a given position.
+   Input: value (ElementType), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool DoublyLinkedList::insert(const ElementType& value, int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int node = acquire();
+    if (node == NULL_INDEX) {
+        return false;
+    }
+    pool->data(node) = value;
+    linkBefore(node, position == mySize ? int(NULL_INDEX) : nodeAt(position));
+    return true;
+}
+
+/* -----------------------------
+   insert() (move)
+   Purpose: Insert a value at a given position by moving it into the node.
+   Input: value (ElementType rvalue), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool DoublyLinkedList::insert(ElementType&& value, int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int node = acquire();
+    if (node == NULL_INDEX) {
+        return false;
+    }
+    pool->data(node) = std::move(value);
+    linkBefore(node, position == mySize ? int(NULL_INDEX) : nodeAt(position));
+    return true;
+}
+
+/* -----------------------------
+   remove()
+   Purpose: Remove the element at a given position.
+   Input: position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool DoublyLinkedList::remove(int position)
+{
+    if (position < 0 || position >= mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    unlink(nodeAt(position));
+    return true;
+}
+
+/* -----------------------------
+   push_back()
+   Purpose: Append a value after the tail.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool DoublyLinkedList::push_back(const ElementType& value)
+{
+    return insert(value, mySize);
+}
+
+bool DoublyLinkedList::push_back(ElementType&& value)
+{
+    return insert(std::move(value), mySize);
+}
+
+/* -----------------------------
+   push_front()
+   Purpose: Insert a value before the head.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool DoublyLinkedList::push_front(const ElementType& value)
+{
+    return insert(value, 0);
+}
+
+bool DoublyLinkedList::push_front(ElementType&& value)
+{
+    return insert(std::move(value), 0);
+}
+
+/* -----------------------------
+   pop_back()
+   Purpose: Remove the tail through its prev link.
+   Input: None
+   Output: true if successful, false if the list is empty
+   ----------------------------- */
+bool DoublyLinkedList::pop_back()
+{
+    if (tail == NULL_INDEX) {
+        cerr << "Error: List is empty" << endl;
+        return false;
+    }
+    unlink(tail);
+    return true;
+}
+
+/* -----------------------------
+   pop_front()
+   Purpose: Remove the head.
+   Input: None
+   Output: true if successful, false if the list is empty
+   ----------------------------- */
+bool DoublyLinkedList::pop_front()
+{
+    if (head == NULL_INDEX) {
+        cerr << "Error: List is empty" << endl;
+        return false;
+    }
+    unlink(head);
+    return true;
+}
+
+/* -----------------------------
+   iteratorAt()
+   Purpose: Get the iterator for a position.
+   Input: position (int)
+   Output: Iterator to the element, end() for length()
+   ----------------------------- */
+DoublyLinkedList::iterator DoublyLinkedList::iteratorAt(int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return end();
+    }
+    return iterator(this, position == mySize ? int(NULL_INDEX) : nodeAt(position));
+}
+
+DoublyLinkedList::const_iterator DoublyLinkedList::iteratorAt(int position) const
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return end();
+    }
+    return const_iterator(this, position == mySize ? int(NULL_INDEX) : nodeAt(position));
+}
+
+/* -----------------------------
+   insert_before()
+   Purpose: Insert a value in front of an iterator in O(1).
+   Input: position (const_iterator), value (ElementType)
+   Output: Iterator to the new element, end() on failure
+   ----------------------------- */
+DoublyLinkedList::iterator DoublyLinkedList::insert_before(const_iterator position, const ElementType& value)
+{
+    int node = acquire();
+    if (node == NULL_INDEX) {
+        return end();
+    }
+    pool->data(node) = value;
+    linkBefore(node, position.node);
+    return iterator(this, node);
+}
+
+DoublyLinkedList::iterator DoublyLinkedList::insert_before(const_iterator position, ElementType&& value)
+{
+    int node = acquire();
+    if (node == NULL_INDEX) {
+        return end();
+    }
+    pool->data(node) = std::move(value);
+    linkBefore(node, position.node);
+    return iterator(this, node);
+}
+
+/* -----------------------------
+   insert_after()
+   Purpose: Insert a value behind an iterator in O(1).
+   Input: position (const_iterator), value (ElementType)
+   Output: Iterator to the new element, end() on failure
+   ----------------------------- */
+DoublyLinkedList::iterator DoublyLinkedList::insert_after(const_iterator position, const ElementType& value)
+{
+    if (position.node == NULL_INDEX) {
+        cerr << "Error: Cannot insert after end()" << endl;
+        return end();
+    }
+    return insert_before(const_iterator(this, pool->next(position.node)), value);
+}
+
+DoublyLinkedList::iterator DoublyLinkedList::insert_after(const_iterator position, ElementType&& value)
+{
+    if (position.node == NULL_INDEX) {
+        cerr << "Error: Cannot insert after end()" << endl;
+        return end();
+    }
+    return insert_before(const_iterator(this, pool->next(position.node)), std::move(value));
+}
+
+/* -----------------------------
+   erase()
+   Purpose: Remove the element at an iterator in O(1).
+   Input: position (const_iterator)
+   Output: Iterator to the following element
+   ----------------------------- */
+DoublyLinkedList::iterator DoublyLinkedList::erase(const_iterator position)
+{
+    if (position.node == NULL_INDEX) {
+        cerr << "Error: Cannot erase end()" << endl;
+        return end();
+    }
+    return iterator(this, unlink(position.node));
+}
+
+/* -----------------------------
+   begin() / end()
+   Purpose: Iterators over the elements in list order.
+   Input: None
+   Output: First element / one past the last
+   ----------------------------- */
+DoublyLinkedList::iterator DoublyLinkedList::begin()
+{
+    return iterator(this, head);
+}
+
+DoublyLinkedList::iterator DoublyLinkedList::end()
+{
+    return iterator(this, NULL_INDEX);
+}
+
+DoublyLinkedList::const_iterator DoublyLinkedList::begin() const
+{
+    return const_iterator(this, head);
+}
+
+DoublyLinkedList::const_iterator DoublyLinkedList::end() const
+{
+    return const_iterator(this, NULL_INDEX);
+}
+
+DoublyLinkedList::const_iterator DoublyLinkedList::cbegin() const
+{
+    return begin();
+}
+
+DoublyLinkedList::const_iterator DoublyLinkedList::cend() const
+{
+    return end();
+}
+
+/* -----------------------------
+   rbegin() / rend()
+   Purpose: Iterators over the elements from last to first.
+   Input: None
+   Output: Last element / one before the first
+   ----------------------------- */
+DoublyLinkedList::reverse_iterator DoublyLinkedList::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+DoublyLinkedList::reverse_iterator DoublyLinkedList::rend()
+{
+    return reverse_iterator(begin());
+}
+
+DoublyLinkedList::const_reverse_iterator DoublyLinkedList::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+DoublyLinkedList::const_reverse_iterator DoublyLinkedList::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+DoublyLinkedList::const_reverse_iterator DoublyLinkedList::crbegin() const
+{
+    return rbegin();
+}
+
+DoublyLinkedList::const_reverse_iterator DoublyLinkedList::crend() const
+{
+    return rend();
+}
+
+/* -----------------------------
+   search()
+   Purpose: Find the position of a value.
+   Input: value (ElementType)
+   Output: Position if found, -1 otherwise
+   ----------------------------- */
+int DoublyLinkedList::search(const ElementType& value) const
+{
+    int position = 0;
+    for (int current = head; current != NULL_INDEX; current = pool->next(current)) {
+        if (pool->data(current) == value) {
+            return position;
+        }
+        position++;
+    }
+    return -1; // Not found
+}
+
+/* -----------------------------
+   display()
+   Purpose: Print all elements in the list.
+   Input: None
+   Output: Elements printed in order
+   ----------------------------- */
+void DoublyLinkedList::display() const
+{
+    int current = head;
+    cout << "List: ";
+    while (current != NULL_INDEX) {
+        cout << pool->data(current) << " ";
+        current = pool->next(current);
+    }
+    cout << endl;
+}
+
+/* -----------------------------
+   Copy Constructor
+   Purpose: Create a deep copy of another list.
+   Input: source (DoublyLinkedList)
+   Output: A new list identical to source
+   ----------------------------- */
+DoublyLinkedList::DoublyLinkedList(const DoublyLinkedList& source)
+{
+    pool = source.pool;
+    head = NULL_INDEX;
+    tail = NULL_INDEX;
+    mySize = 0;
+    copyNodes(source);
+}
+
+/* -----------------------------
+   operator=
+   Purpose: Replace the contents with copies of source's elements.
+   Input: source (DoublyLinkedList)
+   Output: *this updated to match source
+   ----------------------------- */
+DoublyLinkedList& DoublyLinkedList::operator=(const DoublyLinkedList& source)
+{
+    if (this != &source) {
+        clear(); // Current nodes go back as one chain
+        copyNodes(source);
+    }
+    return *this;
+}
+
+/* -----------------------------
+   Move Constructor
+   Purpose: Take over another list's nodes in O(1).
+   Input: source (DoublyLinkedList rvalue)
+   Output: A list holding source's elements; source is empty
+   ----------------------------- */
+DoublyLinkedList::DoublyLinkedList(DoublyLinkedList&& source) noexcept
+{
+    pool = source.pool;
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+}
+
+/* -----------------------------
+   operator= (move)
+   Purpose: Release the current nodes and take over source's.
+   Input: source (DoublyLinkedList rvalue)
+   Output: *this holds source's elements; source is empty
+   ----------------------------- */
+DoublyLinkedList& DoublyLinkedList::operator=(DoublyLinkedList&& source)
+{
+    if (this == &source) {
+        return *this;
+    }
+    if (pool != source.pool) {
+        return *this = static_cast<const DoublyLinkedList&>(source); // Nodes cannot change pools
+    }
+
+    clear();
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+    return *this;
+}
+
+/* -----------------------------
+   copyNodes()
+   Purpose: Copy source's elements into one freshly acquired chain.
+   Input: source (DoublyLinkedList)
+   Output: The empty list now equals source
+   ----------------------------- */
+void DoublyLinkedList::copyNodes(const DoublyLinkedList& source)
+{
+    if (source.head == NULL_INDEX) {
+        return;
+    }
+    int last;
+    int first = pool->acquireNodes(source.mySize, last);
+    if (first == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return;
+    }
+
+    // The chain is already linked through next; fill it and set prev
+    int previous = NULL_INDEX;
+    int from = source.head;
+    for (int current = first; current != NULL_INDEX; current = pool->next(current)) {
+        pool->data(current) = source.pool->data(from);
+        pool->prev(current) = previous;
+        previous = current;
+        from = source.pool->next(from);
+    }
+    head = first;
+    tail = last;
+    mySize = source.mySize;
+}
@@ -0,0 +1,388 @@
+/*-- DoublyLinkedList.h ----------------------------------------------------
+
+  This header file defines the class DoublyLinkedList, a doubly linked
+  list on a DoublyNodePool. Every node keeps a prev link beside its next
+  link, so a node can be unlinked, or a new node linked on either side of
+  it, in O(1) without walking to its predecessor. ArrayBasedList keeps
+  using the singly linked NodePool, whose nodes are one link smaller.
+
+  Basic operations are:
+    Constructor
+    Destructor
+    empty:Check if list is empty
+    insert:Insert an item at a position (copied or moved in)
+    remove:Delete an item at a position
+    push_back/push_front:Add an item at either end in O(1)
+    pop_back/pop_front:Remove the item at either end in O(1)
+    iteratorAt:Get an iterator (node handle) for a position
+    insert_before/insert_after:Insert an item next to an iterator in O(1)
+    erase:Remove the item at an iterator in O(1)
+    begin/end:Bidirectional iterators over the items
+    rbegin/rend:Reverse iterators, from the last item to the first
+    search:Find the position of a value
+    display:Output the list
+
+  Positions are resolved by walking from whichever end is nearer, so
+  insert and remove at position p cost O(min(p, length() - p)). An
+  iterator is the list's node handle: it names one node, stays valid
+  until that node is erased or the list is cleared or assigned, and its
+  nodeIndex() is the node's pool index.
+
+  Copies are deep: the copy takes all its nodes from its own pool with
+  one acquireNodes call. Moving is O(1) within one pool. clear() and the
+  destructor give the whole chain back with one releaseChain call.
+
+-------------------------------------------------------------------------*/
+
+#ifndef DOUBLYLINKEDLIST_H
+#define DOUBLYLINKEDLIST_H
+#include <string>
+#include "nodepool.h"
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+
+class DoublyLinkedList
+{
+public:
+    /*** ListIterator: bidirectional iterator over the values of a list ***/
+    template <typename Value, typename List>
+    class ListIterator
+    {
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef ElementType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        ListIterator() : list(0), node(NULL_INDEX) {}
+        ListIterator(List* owner, int at) : list(owner), node(at) {}
+
+        // iterator converts to const_iterator (not the other way)
+        template <typename OtherValue, typename OtherList>
+        ListIterator(const ListIterator<OtherValue, OtherList>& other)
+            : list(other.list), node(other.node) {}
+
+        reference operator*() const { return list->pool->data(node); }
+        pointer operator->() const { return &list->pool->data(node); }
+
+        ListIterator& operator++()
+        {
+            node = list->pool->next(node);
+            return *this;
+        }
+
+        ListIterator operator++(int)
+        {
+            ListIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        ListIterator& operator--()
+        {
+            node = (node == NULL_INDEX) ? list->tail : list->pool->prev(node);
+            return *this;
+        }
+
+        ListIterator operator--(int)
+        {
+            ListIterator following = *this;
+            --*this;
+            return following;
+        }
+
+        template <typename OtherValue, typename OtherList>
+        bool operator==(const ListIterator<OtherValue, OtherList>& other) const
+        {
+            return node == other.node;
+        }
+
+        template <typename OtherValue, typename OtherList>
+        bool operator!=(const ListIterator<OtherValue, OtherList>& other) const
+        {
+            return node != other.node;
+        }
+
+        int nodeIndex() const { return node; } // Pool index of the element
+
+    private:
+        template <typename, typename> friend class ListIterator;
+        friend class DoublyLinkedList;
+
+        List* list; // List iterated over
+        int node;   // Current node, NULL_INDEX at end()
+    };
+
+    typedef ListIterator<ElementType, DoublyLinkedList> iterator;
+    typedef ListIterator<const ElementType, const DoublyLinkedList> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /******** Function Members ********/
+
+    DoublyLinkedList(DoublyNodePool* externalPool);
+    /*----------------------------------------------------------------------
+      Construct a DoublyLinkedList using an external DoublyNodePool.
+
+      Precondition:  externalPool points to a valid DoublyNodePool object.
+      Postcondition: An empty list is created with head = tail = NULL_INDEX.
+    -----------------------------------------------------------------------*/
+
+    ~DoublyLinkedList();
+    /*----------------------------------------------------------------------
+     Destroy the list and return all nodes to the free list.
+
+     Precondition:  None
+     Postcondition: All nodes in the list are released to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool empty() const;
+    /*----------------------------------------------------------------------
+     Check if the list is empty.
+
+     Precondition:  None
+     Postcondition: Returns true if list is empty, false otherwise.
+    -----------------------------------------------------------------------*/
+
+    bool insert(const ElementType& value, int position);
+    bool insert(ElementType&& value, int position);
+    /*----------------------------------------------------------------------
+     Insert a value (copied or moved into the node) at a given position.
+
+     Precondition:  0 <= position <= current list length; node pool has space.
+     Postcondition: value is inserted at position; list is updated.
+    -----------------------------------------------------------------------*/
+
+    bool remove(int position);
+    /*----------------------------------------------------------------------
+     Remove the node at a given position.
+
+     Precondition:  0 <= position < current list length.
+     Postcondition: Node is removed and returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool push_back(const ElementType& value);
+    bool push_back(ElementType&& value);
+    /*----------------------------------------------------------------------
+     Append a value at the end of the list in O(1).
+
+     Precondition:  node pool has space.
+     Postcondition: value is the last element.
+    -----------------------------------------------------------------------*/
+
+    bool push_front(const ElementType& value);
+    bool push_front(ElementType&& value);
+    /*----------------------------------------------------------------------
+     Insert a value at the front of the list in O(1).
+
+     Precondition:  node pool has space.
+     Postcondition: value is the first element.
+    -----------------------------------------------------------------------*/
+
+    bool pop_back();
+    /*----------------------------------------------------------------------
+     Remove the last element of the list in O(1).
+
+     Precondition:  List is not empty.
+     Postcondition: Last node is returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool pop_front();
+    /*----------------------------------------------------------------------
+     Remove the first element of the list in O(1).
+
+     Precondition:  List is not empty.
+     Postcondition: First node is returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    iterator iteratorAt(int position);
+    const_iterator iteratorAt(int position) const;
+    /*----------------------------------------------------------------------
+      Find the node at a position, walking from the nearer end.
+
+      Precondition:  0 <= position <= current list length.
+      Postcondition: Returns an iterator to it (end() for length(), and
+                     end() with an error for a bad position).
+    -----------------------------------------------------------------------*/
+
+    iterator insert_before(const_iterator position, const ElementType& value);
+    iterator insert_before(const_iterator position, ElementType&& value);
+    /*----------------------------------------------------------------------
+      Insert a value right before an iterator in O(1).
+
+      Precondition:  position is an element of the list or end(); node
+                     pool has space.
+      Postcondition: Returns an iterator to the new element, or end() (with
+                     an error) if the pool is exhausted.
+    -----------------------------------------------------------------------*/
+
+    iterator insert_after(const_iterator position, const ElementType& value);
+    iterator insert_after(const_iterator position, ElementType&& value);
+    /*----------------------------------------------------------------------
+      Insert a value right after an iterator in O(1).
+
+      Precondition:  position is an element of the list; node pool has space.
+      Postcondition: Returns an iterator to the new element, or end() (with
+                     an error) for end() or an exhausted pool.
+    -----------------------------------------------------------------------*/
+
+    iterator erase(const_iterator position);
+    /*----------------------------------------------------------------------
+      Remove the element at an iterator in O(1).
+
+      Precondition:  position is an element of the list.
+      Postcondition: The node is returned to the pool; returns an iterator
+                     to the element that followed it (end() if none, and
+                     end() with an error when position is end()).
+    -----------------------------------------------------------------------*/
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    /*----------------------------------------------------------------------
+      Iterators over the elements in list order; --end() is the last one.
+
+      Precondition:  None
+      Postcondition: begin() == end() for an empty list.
+    -----------------------------------------------------------------------*/
+
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    /*----------------------------------------------------------------------
+      Iterators over the elements from last to first, following prev.
+
+      Precondition:  None
+      Postcondition: rbegin() == rend() for an empty list.
+    -----------------------------------------------------------------------*/
+
+    int search(const ElementType& value) const;
+    /*----------------------------------------------------------------------
+     Search for a value in the list.
+
+     Precondition:  None
+     Postcondition: Returns position of value if found, -1 otherwise.
+    -----------------------------------------------------------------------*/
+
+    void display() const;
+    /*----------------------------------------------------------------------
+     Display the contents of the list.
+
+     Precondition:  None
+     Postcondition: Outputs list elements in order to standard output.
+    -----------------------------------------------------------------------*/
+
+    int length() const;
+    /*----------------------------------------------------------------------
+      Return the number of elements in the list.
+
+      Precondition:  None
+      Postcondition: Returns the count of active nodes in the list.
+    -----------------------------------------------------------------------*/
+
+    void clear();
+    /*----------------------------------------------------------------------
+      Clear the list and return all nodes to the pool.
+
+      Precondition:  None
+      Postcondition: List is empty and all nodes are released.
+    -----------------------------------------------------------------------*/
+
+    /***** Copy constructor *****/
+    DoublyLinkedList(const DoublyLinkedList&);
+    /*----------------------------------------------------------------------
+     Copy constructor.
+
+     Precondition:  None
+     Postcondition: A new list on source's pool holds copies of its
+                    elements (empty, with an error, if the pool is full).
+    -----------------------------------------------------------------------*/
+
+    DoublyLinkedList& operator=(const DoublyLinkedList&);
+    /*----------------------------------------------------------------------
+     Assignment operator.
+
+     Precondition:  None
+     Postcondition: The current list is cleared and replaced with copies
+                    of source's elements taken from this list's pool.
+    -----------------------------------------------------------------------*/
+
+    /***** Move constructor *****/
+    DoublyLinkedList(DoublyLinkedList&& source) noexcept;
+    /*----------------------------------------------------------------------
+     Move constructor; O(1).
+
+     Precondition:  None
+     Postcondition: The new list holds source's nodes; source is empty.
+    -----------------------------------------------------------------------*/
+
+    DoublyLinkedList& operator=(DoublyLinkedList&& source);
+    /*----------------------------------------------------------------------
+     Move assignment.
+
+     Precondition:  None
+     Postcondition: The current nodes are released and source's taken over
+                    in O(1), leaving source empty. Lists on different
+                    pools cannot trade nodes: then this copies.
+    -----------------------------------------------------------------------*/
+
+private:
+    int acquire();
+    /*----------------------------------------------------------------------
+      Take a node for an insert.
+
+      Precondition:  None
+      Postcondition: Returns the node, or NULL_INDEX (with an error) if the
+                     pool is exhausted.
+    -----------------------------------------------------------------------*/
+
+    void linkBefore(int node, int successor);
+    /*----------------------------------------------------------------------
+      Link a node whose data is already set in front of successor
+      (at the end for NULL_INDEX).
+
+      Precondition:  node came from acquire(); successor is in the list or
+                     NULL_INDEX.
+      Postcondition: head, tail and mySize are updated.
+    -----------------------------------------------------------------------*/
+
+    int unlink(int node);
+    /*----------------------------------------------------------------------
+      Take a node out of the list and return it to the pool.
+
+      Precondition:  node is in the list.
+      Postcondition: Returns the node that followed it.
+    -----------------------------------------------------------------------*/
+
+    int nodeAt(int position) const;
+    /*----------------------------------------------------------------------
+      Return the node at position, walking from the nearer end.
+
+      Precondition:  0 <= position < mySize
+    -----------------------------------------------------------------------*/
+
+    void copyNodes(const DoublyLinkedList& source);
+    /*----------------------------------------------------------------------
+      Fill an empty list with copies of source's nodes.
+
+      Precondition:  The list is empty.
+      Postcondition: The list equals source (empty on pool exhaustion).
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+
+    int head; // Index of first node in the list
+    int tail; // Index of last node in the list
+    DoublyNodePool* pool; // Pointer to external node pool
+    int mySize; // Number of elements
+};
+
+#endif
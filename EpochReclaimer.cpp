@@ -0,0 +1,153 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ArrayBasedList Concurrent Readers
+ *
+ * Description:
+ * This file implements epoch-based reclamation of list nodes: readers
+ * announce the epoch they entered in, and the writer releases a retired
+ * node only after the epoch has advanced twice since its retirement.
+ */
+
+#include "EpochReclaimer.h"
+#include <functional>
+#include <thread>
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Create a reclaimer with every reader slot free.
+   Input: listPool (pointer to NodePool)
+   Output: Epoch 1, nothing retired
+   ----------------------------- */
+EpochReclaimer::EpochReclaimer(NodePool* listPool)
+    : listPool(listPool)
+{
+    globalEpoch.store(1);
+    for (int s = 0; s < READER_SLOTS; s++) {
+        slots[s].epoch.store(0);
+    }
+    sinceReclaim = 0;
+}
+
+/* -----------------------------
+   Destructor
+   Purpose: Give every retired node back to the pool.
+   Input: None
+   Output: Nothing pending
+   ----------------------------- */
+EpochReclaimer::~EpochReclaimer()
+{
+    drain();
+}
+
+/* -----------------------------
+   enter()
+   Purpose: Announce a reader in a free slot.
+   Input: None
+   Output: Slot index the reader holds
+   ----------------------------- */
+int EpochReclaimer::enter()
+{
+    // Start looking at a slot picked by thread, so readers rarely collide
+    static thread_local int hint = int(hash<thread::id>()(this_thread::get_id()) % READER_SLOTS);
+    while (true) {
+        unsigned long long epoch = globalEpoch.load();
+        for (int i = 0; i < READER_SLOTS; i++) {
+            int s = (hint + i) % READER_SLOTS;
+            unsigned long long expected = 0;
+            if (slots[s].epoch.load(memory_order_relaxed) == 0 &&
+                slots[s].epoch.compare_exchange_strong(expected, epoch)) {
+                // Pairs with the fence in reclaim(): either the writer sees
+                // this slot, or this reader sees every unlink before it
+                atomic_thread_fence(memory_order_seq_cst);
+                hint = s;
+                return s;
+            }
+        }
+        this_thread::yield(); // Every slot is busy
+    }
+}
+
+/* -----------------------------
+   exit()
+   Purpose: Leave the read-side critical section.
+   Input: slot (int)
+   Output: Slot free again
+   ----------------------------- */
+void EpochReclaimer::exit(int slot)
+{
+    slots[slot].epoch.store(0, memory_order_release);
+}
+
+/* -----------------------------
+   retire()
+   Purpose: Queue an unlinked node for release after its grace period.
+   Input: node (int)
+   Output: Node queued; older nodes released every RECLAIM_BATCH calls
+   ----------------------------- */
+void EpochReclaimer::retire(int node)
+{
+    Retired entry = { node, globalEpoch.load(memory_order_relaxed) };
+    retired.push_back(entry);
+    if (++sinceReclaim >= RECLAIM_BATCH) {
+        reclaim();
+    }
+}
+
+/* -----------------------------
+   reclaim()
+   Purpose: Advance the epoch if possible and release expired nodes.
+   Input: None
+   Output: Number of nodes released
+   ----------------------------- */
+size_t EpochReclaimer::reclaim()
+{
+    sinceReclaim = 0;
+
+    // The unlinks so far happen before the slots are read
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned long long epoch = globalEpoch.load(memory_order_relaxed);
+    bool everyoneCurrent = true;
+    for (int s = 0; s < READER_SLOTS && everyoneCurrent; s++) {
+        unsigned long long seen = slots[s].epoch.load();
+        everyoneCurrent = (seen == 0 || seen == epoch);
+    }
+    if (everyoneCurrent) {
+        epoch++; // Single writer: no other thread advances the epoch
+        globalEpoch.store(epoch);
+    }
+
+    size_t released = 0;
+    while (!retired.empty() && retired.front().epoch + 2 <= epoch) {
+        listPool->releaseNode(retired.front().node);
+        retired.pop_front();
+        released++;
+    }
+    return released;
+}
+
+/* -----------------------------
+   drain()
+   Purpose: Release every retired node at once.
+   Input: None
+   Output: Nothing pending
+   ----------------------------- */
+void EpochReclaimer::drain()
+{
+    while (!retired.empty()) {
+        listPool->releaseNode(retired.front().node);
+        retired.pop_front();
+    }
+    sinceReclaim = 0;
+}
+
+/* -----------------------------
+   pending()
+   Purpose: Count the retired nodes not yet released.
+   Input: None
+   Output: Number of nodes
+   ----------------------------- */
+size_t EpochReclaimer::pending() const
+{
+    return retired.size();
+}
@@ -0,0 +1,134 @@
+/*-- EpochReclaimer.h ------------------------------------------------------
+
+  This header file defines the class EpochReclaimer, which ArrayBasedList
+  keeps while it has concurrent readers: one writer thread changes the
+  list while any number of threads search and iterate it without locks.
+  The writer no longer returns a removed node to the NodePool at once,
+  because a reader may still be standing on it; the node is retired and
+  only released once every reader that could have seen it has left.
+
+  This is epoch-based reclamation. A global epoch counter only moves
+  forward. A reader announces the epoch it saw in one of READER_SLOTS
+  slots when it starts (enter) and clears the slot when it is done
+  (exit). The writer tags every retired node with the epoch of its
+  retirement and may advance the epoch when every announced reader has
+  seen the current one. A node retired in epoch e was unlinked before any
+  reader announcing e + 1 started, so once the epoch reaches e + 2 no
+  reader can reach it and it goes back to the pool.
+
+  A reader that stays inside for long only delays reclamation: retired
+  nodes wait in the reclaimer and the writer never blocks. A thread takes
+  a free slot for each enter() and gives it back on exit(), so nothing
+  has to be registered per thread; when all slots are busy enter() waits
+  for one.
+
+  Basic operations are:
+    Constructor
+    Destructor
+    enter/exit:Start and end a read-side critical section
+    retire:Hand over an unlinked node to be released later
+    reclaim:Advance the epoch if possible and release expired nodes
+    drain:Release every retired node (no reader may be active)
+    pending:Number of retired nodes not yet released
+
+-------------------------------------------------------------------------*/
+
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+#include "nodepool.h"
+#include <atomic>
+#include <deque>
+
+const int READER_SLOTS = 128; // Readers that can be inside at the same time.
+
+class EpochReclaimer
+{
+public:
+    /******** Function Members ********/
+
+    EpochReclaimer(NodePool* listPool);
+    /*----------------------------------------------------------------------
+      Construct a reclaimer for nodes of listPool.
+
+      Precondition:  listPool points to the NodePool of the list.
+      Postcondition: No reader is inside and nothing is retired.
+    -----------------------------------------------------------------------*/
+
+    ~EpochReclaimer();
+    /*----------------------------------------------------------------------
+      Release every retired node to the pool.
+
+      Precondition:  No reader is inside.
+    -----------------------------------------------------------------------*/
+
+    int enter();
+    void exit(int slot);
+    /*----------------------------------------------------------------------
+      Start and end a read-side critical section; any thread may call
+      them. Nodes reachable from the list when enter() returns are not
+      released before the matching exit().
+
+      Precondition:  exit: slot was returned by enter() on this thread.
+      Postcondition: enter returns the slot the reader occupies.
+    -----------------------------------------------------------------------*/
+
+    void retire(int node);
+    /*----------------------------------------------------------------------
+      Retire a node the writer has unlinked from the list. Every
+      RECLAIM_BATCH retirements the writer also calls reclaim().
+
+      Precondition:  Writer thread; node is no longer reachable from the
+                     list head, and its next link is left as it was.
+      Postcondition: The node is released once no reader can reach it.
+    -----------------------------------------------------------------------*/
+
+    size_t reclaim();
+    /*----------------------------------------------------------------------
+      Advance the epoch if every reader inside has seen it, then release
+      the nodes retired two or more epochs ago.
+
+      Precondition:  Writer thread.
+      Postcondition: Returns the number of nodes released.
+    -----------------------------------------------------------------------*/
+
+    void drain();
+    /*----------------------------------------------------------------------
+      Release every retired node at once.
+
+      Precondition:  Writer thread; no reader is inside.
+      Postcondition: pending() is 0.
+    -----------------------------------------------------------------------*/
+
+    size_t pending() const;
+    /*----------------------------------------------------------------------
+      Return the number of retired nodes that are not yet released.
+
+      Precondition:  Writer thread.
+    -----------------------------------------------------------------------*/
+
+private:
+    enum { RECLAIM_BATCH = 64 }; // Retirements between reclaim() calls
+
+    /*** ReaderSlot: epoch announced by one reader, 0 if free ***/
+    struct alignas(64) ReaderSlot
+    {
+        atomic<unsigned long long> epoch;
+    };
+
+    /*** Retired: a node waiting for its grace period ***/
+    struct Retired
+    {
+        int node;                 // Unlinked list node
+        unsigned long long epoch; // Epoch it was retired in
+    };
+
+    /******** Data Members ********/
+
+    NodePool* listPool; // Pool the nodes are released to
+    atomic<unsigned long long> globalEpoch; // Current epoch, starts at 1
+    ReaderSlot slots[READER_SLOTS]; // Epochs announced by readers inside
+    deque<Retired> retired; // Retired nodes, oldest first (writer only)
+    size_t sinceReclaim; // Retirements since the last reclaim()
+};
+
+#endif
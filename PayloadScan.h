@@ -0,0 +1,205 @@
+/*-- PayloadScan.h -----------------------------------------------------------
+
+  This header file defines PayloadScan, which finds a value in a dense
+  array of payloads. NodePool uses it to search the payload arrays of its
+  segments front to back instead of following links, so a search reads
+  memory sequentially at full bandwidth.
+
+  Types whose equality is their bytes (trivially copyable, no padding or
+  other bytes that do not take part in the value: integers, enums and
+  structs made of them) are scanned with vector compares:
+
+     4 and 8 bytes: AVX2 (8 or 4 items per compare) or SSE2/SSE4.1
+     16 bytes:      AVX2 (2 items per compare) or SSE2 (1 item)
+     other sizes:   memcmp per item
+
+  The instruction set is chosen at compile time from what the compiler
+  may use (for example -mavx2 or -march=native); without SSE2, as on
+  non-x86 targets, every size uses the scalar loop. AVAILABLE is false
+  for types such as string and double, whose == is not a byte compare;
+  find() then compares items one by one with ==.
+
+  AVAILABLE is decided from the type's layout alone. A struct without
+  padding whose operator== does not compare all of its bytes (say, an id
+  with a flag member that == ignores) would be scanned bytewise and must
+  not be searched this way.
+
+-----------------------------------------------------------------------------*/
+
+#ifndef PAYLOADSCAN_H
+#define PAYLOADSCAN_H
+
+using namespace std;
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*** ScanKernel: bytewise search over items of one width ***/
+template <size_t Width>
+struct ScanKernel
+{
+    // Any width: compare the bytes of each item
+    static size_t find(const char* items, size_t count, const char* key)
+    {
+        for (size_t i = 0; i < count; i++) {
+            if (memcmp(items + i * Width, key, Width) == 0) {
+                return i;
+            }
+        }
+        return count;
+    }
+};
+
+template <>
+struct ScanKernel<4>
+{
+    static size_t find(const char* items, size_t count, const char* key)
+    {
+        uint32_t word;
+        memcpy(&word, key, 4);
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256i wanted = _mm256_set1_epi32(int(word));
+        for (; i + 8 <= count; i += 8) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i * 4));
+            unsigned mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi32(block, wanted)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask) / 4;
+            }
+        }
+#elif defined(__SSE2__)
+        __m128i wanted = _mm_set1_epi32(int(word));
+        for (; i + 4 <= count; i += 4) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i * 4));
+            unsigned mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi32(block, wanted)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask) / 4;
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            uint32_t item;
+            memcpy(&item, items + i * 4, 4);
+            if (item == word) {
+                return i;
+            }
+        }
+        return count;
+    }
+};
+
+template <>
+struct ScanKernel<8>
+{
+    static size_t find(const char* items, size_t count, const char* key)
+    {
+        uint64_t word;
+        memcpy(&word, key, 8);
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256i wanted = _mm256_set1_epi64x((long long)word);
+        for (; i + 4 <= count; i += 4) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i * 8));
+            unsigned mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi64(block, wanted)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask) / 8;
+            }
+        }
+#elif defined(__SSE2__)
+        __m128i wanted = _mm_set1_epi64x((long long)word);
+        for (; i + 2 <= count; i += 2) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i * 8));
+#if defined(__SSE4_1__)
+            unsigned mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi64(block, wanted)));
+#else
+            // 32-bit halves: an item matches when all 8 of its mask bits are set
+            unsigned mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi32(block, wanted)));
+            mask = ((mask & 0xFF) == 0xFF ? 0xFF : 0) | ((mask & 0xFF00) == 0xFF00 ? 0xFF00 : 0);
+#endif
+            if (mask != 0) {
+                return i + __builtin_ctz(mask) / 8;
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            uint64_t item;
+            memcpy(&item, items + i * 8, 8);
+            if (item == word) {
+                return i;
+            }
+        }
+        return count;
+    }
+};
+
+template <>
+struct ScanKernel<16>
+{
+    static size_t find(const char* items, size_t count, const char* key)
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256i wanted = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(key)));
+        for (; i + 2 <= count; i += 2) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i * 16));
+            unsigned mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wanted)));
+            if ((mask & 0xFFFF) == 0xFFFF) {
+                return i;
+            }
+            if ((mask >> 16) == 0xFFFF) {
+                return i + 1;
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        __m128i one = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        for (; i < count; i++) {
+            __m128i item = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i * 16));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(item, one)) == 0xFFFF) {
+                return i;
+            }
+        }
+#else
+        for (; i < count; i++) {
+            if (memcmp(items + i * 16, key, 16) == 0) {
+                return i;
+            }
+        }
+#endif
+        return count;
+    }
+};
+
+/*** PayloadScan: search of a payload array, vectorized when possible ***/
+template <typename T>
+struct PayloadScan
+{
+    static const bool AVAILABLE = is_trivially_copyable<T>::value &&
+                                  has_unique_object_representations<T>::value;
+
+    static size_t find(const T* items, size_t count, const T& key)
+    {
+        /*------------------------------------------------------------------
+          Return the offset of the first item equal to key, or count if
+          there is none.
+        -------------------------------------------------------------------*/
+        if constexpr (AVAILABLE) {
+            return ScanKernel<sizeof(T)>::find(reinterpret_cast<const char*>(items), count,
+                                               reinterpret_cast<const char*>(&key));
+        }
+        else {
+            for (size_t i = 0; i < count; i++) {
+                if (items[i] == key) {
+                    return i;
+                }
+            }
+            return count;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*-- PoolStats.h -------------------------------------------------------------
+
+  This header file defines the statistics that NodePool and ArrayBasedList
+  can collect, and the compile-time switch that turns collection on.
+
+  Collection is compiled in only when NODEPOOL_STATS is defined (for
+  example with -DNODEPOOL_STATS). Without it the counters are not members
+  of any class and every STATS_ONLY(...) statement compiles to nothing, so
+  the hot paths are exactly what they are without instrumentation. stats()
+  is available either way; with collection off it still reports what the
+  pool tracks for itself (nodes in use, capacity) and zeros elsewhere.
+
+  Counters are atomics written with relaxed ordering. A metrics thread may
+  call stats() at any time while another thread works on the pool or the
+  list; each field is read atomically but the snapshot as a whole is not,
+  so fields may come from slightly different moments.
+
+  Traversal steps are kept as log2 histograms: bucket 0 counts operations
+  that followed no link, bucket b counts those that needed between
+  2^(b-1) and 2^b - 1 steps.
+
+  Basic operations are:
+     StatCounter:Counter written by one thread or by many
+     StepRecorder:Live histogram of steps per operation
+     StepHistogram:Snapshot of a StepRecorder
+     PoolStats:Snapshot of a pool's counters
+     ListStats:Snapshot of a list's step histograms
+
+-----------------------------------------------------------------------------*/
+
+#ifndef POOLSTATS_H
+#define POOLSTATS_H
+
+using namespace std;
+#include <atomic>
+#include <cstddef>
+
+#ifdef NODEPOOL_STATS
+#define STATS_ONLY(statement) statement
+#else
+#define STATS_ONLY(statement)
+#endif
+
+/*** StepHistogram: steps per operation in log2 buckets ***/
+struct StepHistogram
+{
+    enum { BUCKETS = 33 };
+    unsigned long long count[BUCKETS];// count[b]: operations in bucket b
+
+    unsigned long long operations() const
+    {
+        unsigned long long total = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            total += count[b];
+        }
+        return total;
+    }
+};
+
+/*** PoolStats: snapshot of a NodePool ***/
+struct PoolStats
+{
+    size_t inUse;// Nodes currently acquired (same as length())
+    size_t capacity;// Nodes allocated in all segments
+    size_t highWater;// Most nodes ever off the free list at once
+    unsigned long long acquires;// Nodes handed out
+    unsigned long long releases;// Nodes given back
+    unsigned long long failures;// Acquire calls that found the pool full
+};
+
+/*** ListStats: snapshot of an ArrayBasedList ***/
+struct ListStats
+{
+    StepHistogram insert;// Links followed to reach the insert position
+    StepHistogram remove;// Links followed to reach the removed node
+    StepHistogram search;// Nodes examined by search()
+};
+
+/*** StatCounter: a counter that a metrics thread can read ***/
+class StatCounter
+{
+public:
+    StatCounter() : value(0) {}
+
+    // shared: other threads may update it too (atomic read-modify-write);
+    // otherwise a plain load and store are enough and cost no lock
+    void add(unsigned long long n, bool shared)
+    {
+        if (shared)
+            value.fetch_add(n, memory_order_relaxed);
+        else
+            value.store(value.load(memory_order_relaxed) + n, memory_order_relaxed);
+    }
+
+    void subtract(unsigned long long n, bool shared)
+    {
+        if (shared)
+            value.fetch_sub(n, memory_order_relaxed);
+        else
+            value.store(value.load(memory_order_relaxed) - n, memory_order_relaxed);
+    }
+
+    void raiseTo(unsigned long long n, bool shared)
+    {
+        unsigned long long current = value.load(memory_order_relaxed);
+        while (current < n) {
+            if (!shared) {
+                value.store(n, memory_order_relaxed);
+                return;
+            }
+            if (value.compare_exchange_weak(current, n, memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    void set(unsigned long long n) { value.store(n, memory_order_relaxed); }
+    unsigned long long get() const { return value.load(memory_order_relaxed); }
+
+private:
+    atomic<unsigned long long> value;
+};
+
+/*** StepRecorder: live StepHistogram, written by one thread ***/
+class StepRecorder
+{
+public:
+    void record(size_t steps)
+    {
+        int bucket = 0;
+        while (steps != 0 && bucket < StepHistogram::BUCKETS - 1) {
+            bucket++; // floor(log2(steps)) + 1
+            steps >>= 1;
+        }
+        buckets[bucket].add(1, false);
+    }
+
+    void snapshot(StepHistogram& histogram) const
+    {
+        for (int b = 0; b < StepHistogram::BUCKETS; b++) {
+            histogram.count[b] = buckets[b].get();
+        }
+    }
+
+    void reset()
+    {
+        for (int b = 0; b < StepHistogram::BUCKETS; b++) {
+            buckets[b].set(0);
+        }
+    }
+
+private:
+    StatCounter buckets[StepHistogram::BUCKETS];
+};
+
+#endif
@@ -0,0 +1,377 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ArrayBasedList Position Index
+ *
+ * Description:
+ * This file implements an indexed skip list over the positions of an
+ * ArrayBasedList. Each upper level skips over a number of positions
+ * (its width), so a position is reached in O(log n) expected steps
+ * instead of walking the list from its head.
+ */
+
+#include "PositionIndex.h"
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Create an empty index for a list stored in listPool.
+   Input: listPool (pointer to NodePool)
+   Output: Index describing an empty list
+   ----------------------------- */
+PositionIndex::PositionIndex(const NodePool* listPool)
+    : listPool(listPool), entries(64)
+{
+    seed = 2463534242u;
+    clear();
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Drop all entries and reset every level header.
+   Input: None
+   Output: Index describing an empty list
+   ----------------------------- */
+void PositionIndex::clear()
+{
+    if (!promoted.empty()) {
+        // Forget promoted nodes by walking level 1 only
+        for (int e = headNext[1]; e != NULL_INDEX; e = entries.next(e)) {
+            setLevelOneEntry(entries.data(e).down, NULL_INDEX);
+        }
+    }
+    entries.initializePool();
+    for (int l = 0; l < MAX_LEVEL; l++) {
+        headNext[l] = NULL_INDEX;
+        headWidth[l] = 1; // From position -1 to the end of an empty list
+    }
+    topLevel = 0;
+    mySize = 0;
+}
+
+/* -----------------------------
+   size()
+   Purpose: Length of the indexed list.
+   Input: None
+   Output: Number of positions
+   ----------------------------- */
+int PositionIndex::size() const
+{
+    return mySize;
+}
+
+/* -----------------------------
+   randomLevel()
+   Purpose: Draw how many upper levels a new node gets.
+   Input: None
+   Output: Level in [0, MAX_LEVEL - 1]
+   ----------------------------- */
+int PositionIndex::randomLevel()
+{
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    int level = 0;
+    unsigned int bits = seed;
+    while ((bits & 3) == 0 && level < MAX_LEVEL - 1) {
+        level++; // Promote with probability 1/4
+        bits >>= 2;
+        if (bits == 0) {
+            break;
+        }
+    }
+    return level;
+}
+
+/* -----------------------------
+   Entry accessors
+   Purpose: Read and write links and widths; NULL_INDEX is the header.
+   ----------------------------- */
+inline int PositionIndex::nextOf(int level, int entry) const
+{
+    return entry == NULL_INDEX ? headNext[level] : entries.next(entry);
+}
+
+inline int PositionIndex::widthOf(int level, int entry) const
+{
+    return entry == NULL_INDEX ? headWidth[level] : entries.data(entry).width;
+}
+
+inline void PositionIndex::setNext(int level, int entry, int next)
+{
+    if (entry == NULL_INDEX)
+        headNext[level] = next;
+    else
+        entries.next(entry) = next;
+}
+
+inline void PositionIndex::setWidth(int level, int entry, int width)
+{
+    if (entry == NULL_INDEX)
+        headWidth[level] = width;
+    else
+        entries.data(entry).width = width;
+}
+
+/* -----------------------------
+   levelOneEntry() / setLevelOneEntry()
+   Purpose: Map list nodes to their level 1 entry.
+   ----------------------------- */
+inline int PositionIndex::levelOneEntry(int node) const
+{
+    return size_t(node) < promoted.size() ? promoted[node] : NULL_INDEX;
+}
+
+inline void PositionIndex::setLevelOneEntry(int node, int entry)
+{
+    if (size_t(node) >= promoted.size()) {
+        if (entry == NULL_INDEX) {
+            return;
+        }
+        promoted.resize(listPool->capacity(), NULL_INDEX); // Pool may have grown
+    }
+    promoted[node] = entry;
+}
+
+/* -----------------------------
+   findPredecessors()
+   Purpose: On every level, find the last entry at or before target.
+   Input: target (int), preds / predPos (arrays of MAX_LEVEL)
+   Output: preds[l] and predPos[l] for l = 1..topLevel
+   ----------------------------- */
+void PositionIndex::findPredecessors(int target, int* preds, int* predPos) const
+{
+    int current = NULL_INDEX; // Header of the top level
+    int pos = -1;
+
+    for (int l = topLevel; l >= 1; l--) {
+        // Move right while the next entry is still at or before target
+        int next = nextOf(l, current);
+        while (next != NULL_INDEX && pos + widthOf(l, current) <= target) {
+            pos += widthOf(l, current);
+            current = next;
+            next = nextOf(l, current);
+        }
+        preds[l] = current;
+        predPos[l] = pos;
+
+        // Drop to the same node one level down
+        if (l > 1 && current != NULL_INDEX) {
+            current = entries.data(current).down;
+        }
+    }
+}
+
+/* -----------------------------
+   nodeAt()
+   Purpose: Resolve a position to a list node index.
+   Input: head (int), position (int)
+   Output: Index of the list node at position
+   ----------------------------- */
+int PositionIndex::nodeAt(int head, int position) const
+{
+    int preds[MAX_LEVEL];
+    int predPos[MAX_LEVEL];
+
+    int current = head;
+    int pos = 0;
+    if (topLevel > 0) {
+        findPredecessors(position, preds, predPos);
+        if (preds[1] != NULL_INDEX) {
+            current = entries.data(preds[1]).down;
+            pos = predPos[1];
+        }
+    }
+
+    // Finish on level 0 (the list itself)
+    for (; pos < position; pos++) {
+        current = listPool->next(current);
+    }
+    return current;
+}
+
+/* -----------------------------
+   rankOf()
+   Purpose: Resolve a list node index to its position.
+   Input: node (int)
+   Output: Position of node in the list
+   ----------------------------- */
+int PositionIndex::rankOf(int node) const
+{
+    int distance = 0; // Positions from node to the end of the list
+
+    // Level 0: walk to the first promoted node
+    int current = node;
+    while (current != NULL_INDEX && levelOneEntry(current) == NULL_INDEX) {
+        distance++;
+        current = listPool->next(current);
+    }
+    if (current == NULL_INDEX) {
+        return mySize - distance;
+    }
+
+    // Upper levels: climb when possible, otherwise move right
+    int entry = levelOneEntry(current);
+    while (true) {
+        const IndexEntry& data = entries.data(entry);
+        if (data.up != NULL_INDEX) {
+            entry = data.up;
+            continue;
+        }
+        distance += data.width;
+        entry = entries.next(entry);
+        if (entry == NULL_INDEX) {
+            break; // Width of the last entry reaches the end
+        }
+    }
+    return mySize - distance;
+}
+
+/* -----------------------------
+   inserted()
+   Purpose: Shift positions after an insert and promote the new node.
+   Input: position (int), node (int)
+   Output: None
+   ----------------------------- */
+void PositionIndex::inserted(int position, int node)
+{
+    int level = randomLevel();
+    for (int l = topLevel + 1; l <= level; l++) {
+        headNext[l] = NULL_INDEX;
+        headWidth[l] = mySize + 1; // Empty level spans the whole list
+    }
+    if (level > topLevel) {
+        topLevel = level;
+    }
+
+    int preds[MAX_LEVEL];
+    int predPos[MAX_LEVEL];
+    findPredecessors(position - 1, preds, predPos);
+
+    int below = node; // What the new entry on level l points down to
+    for (int l = 1; l <= topLevel; l++) {
+        int pred = preds[l];
+        int width = widthOf(l, pred);
+
+        int entry = NULL_INDEX;
+        if (l <= level && below != NULL_INDEX) {
+            entry = entries.acquireNode();
+        }
+
+        if (entry == NULL_INDEX) {
+            // Node not on this level: one more position under pred
+            setWidth(l, pred, width + 1);
+            below = NULL_INDEX; // Nothing to stack on higher levels
+            continue;
+        }
+
+        // Old next entry was at predPos + width and moves to +1
+        entries.data(entry).down = below;
+        entries.data(entry).up = NULL_INDEX;
+        entries.data(entry).width = predPos[l] + width + 1 - position;
+        if (l == 1) {
+            setLevelOneEntry(node, entry);
+        }
+        else {
+            entries.data(below).up = entry;
+        }
+        entries.next(entry) = nextOf(l, pred);
+        setNext(l, pred, entry);
+        setWidth(l, pred, position - predPos[l]);
+        below = entry;
+    }
+
+    mySize++;
+}
+
+/* -----------------------------
+   removed()
+   Purpose: Release the removed node's entries and shift positions.
+   Input: position (int)
+   Output: None
+   ----------------------------- */
+void PositionIndex::removed(int position)
+{
+    int preds[MAX_LEVEL];
+    int predPos[MAX_LEVEL];
+    findPredecessors(position - 1, preds, predPos);
+
+    for (int l = 1; l <= topLevel; l++) {
+        int pred = preds[l];
+        int width = widthOf(l, pred);
+        int next = nextOf(l, pred);
+
+        if (next != NULL_INDEX && predPos[l] + width == position) {
+            // The removed node has an entry here: splice it out
+            if (l == 1) {
+                setLevelOneEntry(entries.data(next).down, NULL_INDEX);
+            }
+            setWidth(l, pred, width + widthOf(l, next) - 1);
+            setNext(l, pred, nextOf(l, next));
+            entries.releaseNode(next);
+        }
+        else {
+            setWidth(l, pred, width - 1);
+        }
+    }
+
+    while (topLevel > 0 && headNext[topLevel] == NULL_INDEX) {
+        topLevel--;
+    }
+    mySize--;
+}
+
+/* -----------------------------
+   build()
+   Purpose: Rebuild the index for a whole list in one pass.
+   Input: head (int), length (int)
+   Output: Index describing the list
+   ----------------------------- */
+void PositionIndex::build(int head, int length)
+{
+    clear();
+
+    int last[MAX_LEVEL];    // Last entry appended on each level
+    int lastPos[MAX_LEVEL]; // Its position
+    for (int l = 0; l < MAX_LEVEL; l++) {
+        last[l] = NULL_INDEX;
+        lastPos[l] = -1;
+    }
+
+    int current = head;
+    for (int pos = 0; pos < length; pos++) {
+        int level = randomLevel();
+        int below = current;
+        for (int l = 1; l <= level; l++) {
+            int entry = entries.acquireNode();
+            if (entry == NULL_INDEX) {
+                break;
+            }
+            entries.data(entry).down = below;
+            entries.data(entry).up = NULL_INDEX;
+            entries.next(entry) = NULL_INDEX;
+            if (l == 1) {
+                setLevelOneEntry(current, entry);
+            }
+            else {
+                entries.data(below).up = entry;
+            }
+            setNext(l, last[l], entry);
+            setWidth(l, last[l], pos - lastPos[l]);
+            last[l] = entry;
+            lastPos[l] = pos;
+            below = entry;
+            if (l > topLevel) {
+                topLevel = l;
+            }
+        }
+        current = listPool->next(current);
+    }
+
+    // Last entry on each level spans to the end of the list
+    for (int l = 1; l <= topLevel; l++) {
+        setWidth(l, last[l], length - lastPos[l]);
+    }
+    mySize = length;
+}
@@ -0,0 +1,166 @@
+/*-- PositionIndex.h -------------------------------------------------------
+
+  This header file defines the class PositionIndex, an optional indexed
+  skip list that ArrayBasedList can keep over its nodes to resolve a
+  position to a node index in O(log n) expected time.
+
+  Level 0 of the skip list is the list itself. Every node is promoted to
+  level 1 with probability 1/4, to level 2 with probability 1/16, and so
+  on. An entry at level l >= 1 stores the index of the entry for the same
+  node one level down (the list node itself at level 1) and its width: the
+  number of positions from its node to the node of the next entry on the
+  same level (or to the end of the list for the last entry). The index
+  keeps positions only, so it is updated from the position of an insert or
+  remove without touching the list's links.
+
+  Entries also link up to the entry for the same node one level higher,
+  and the index remembers which list nodes have a level 1 entry. That
+  lets rankOf() turn a node index back into its position: walk right to
+  the first promoted node, then climb and walk right to the end of the
+  list, adding up widths, again in O(log n) expected steps.
+
+  Entries live in their own BasicNodePool, the same pool template the list
+  uses, with Node::next linking entries on one level.
+
+  Basic operations are:
+    Constructor
+    nodeAt:Resolve a position to a list node index
+    inserted:Update after a node was inserted at a position
+    removed:Update after the node at a position was removed
+    rankOf:Resolve a list node index to its position
+    build:Rebuild the index from a whole list
+    clear:Drop all entries
+
+-------------------------------------------------------------------------*/
+
+#ifndef POSITIONINDEX_H
+#define POSITIONINDEX_H
+#include "nodepool.h"
+#include <vector>
+
+/*** IndexEntry: payload of one skip list entry ***/
+struct IndexEntry
+{
+    int down;  // Entry one level down, or list node index at level 1
+    int up;    // Entry one level up for the same node, or NULL_INDEX
+    int width; // Positions from this entry to the next one on its level
+};
+
+class PositionIndex
+{
+public:
+    /******** Function Members ********/
+
+    PositionIndex(const NodePool* listPool);
+    /*----------------------------------------------------------------------
+      Construct an empty index for lists stored in listPool.
+
+      Precondition:  listPool points to the NodePool of the indexed list.
+      Postcondition: The index describes an empty list.
+    -----------------------------------------------------------------------*/
+
+    int nodeAt(int head, int position) const;
+    /*----------------------------------------------------------------------
+      Resolve a position to the index of the list node stored there.
+
+      Precondition:  head is the list head; 0 <= position < list length.
+      Postcondition: Returns the node index after O(log n) expected steps.
+    -----------------------------------------------------------------------*/
+
+    int rankOf(int node) const;
+    /*----------------------------------------------------------------------
+      Return the position of a list node.
+
+      Precondition:  node is a node of the indexed list.
+      Postcondition: Returns its position after O(log n) expected steps.
+    -----------------------------------------------------------------------*/
+
+    void inserted(int position, int node);
+    /*----------------------------------------------------------------------
+      Record that node was inserted into the list at position.
+
+      Precondition:  0 <= position <= size().
+      Postcondition: Later positions are shifted by one; node may get
+                     entries on upper levels (fewer if the entry pool is
+                     exhausted, which only costs speed).
+    -----------------------------------------------------------------------*/
+
+    void removed(int position);
+    /*----------------------------------------------------------------------
+      Record that the node at position was removed from the list.
+
+      Precondition:  0 <= position < size().
+      Postcondition: The node's entries are released; later positions are
+                     shifted down by one.
+    -----------------------------------------------------------------------*/
+
+    void build(int head, int length);
+    /*----------------------------------------------------------------------
+      Rebuild the index for the list starting at head in one pass.
+
+      Precondition:  head is the list head and length its size.
+      Postcondition: The index describes the list.
+    -----------------------------------------------------------------------*/
+
+    void clear();
+    /*----------------------------------------------------------------------
+      Drop all entries.
+
+      Precondition:  None
+      Postcondition: The index describes an empty list.
+    -----------------------------------------------------------------------*/
+
+    int size() const;
+    /*----------------------------------------------------------------------
+      Return the length of the list the index describes.
+
+      Precondition:  None
+      Postcondition: Returns the number of positions indexed.
+    -----------------------------------------------------------------------*/
+
+private:
+    enum { MAX_LEVEL = 32 }; // Level 0 is the list itself
+
+    int randomLevel();
+    /*----------------------------------------------------------------------
+      Draw the number of upper levels for a new node (geometric, p = 1/4).
+    -----------------------------------------------------------------------*/
+
+    int nextOf(int level, int entry) const;
+    int widthOf(int level, int entry) const;
+    void setNext(int level, int entry, int next);
+    void setWidth(int level, int entry, int width);
+    /*----------------------------------------------------------------------
+      Access the link and width of an entry; entry NULL_INDEX stands for
+      the header of the level, which sits at position -1.
+    -----------------------------------------------------------------------*/
+
+    int levelOneEntry(int node) const;
+    void setLevelOneEntry(int node, int entry);
+    /*----------------------------------------------------------------------
+      Look up or record the level 1 entry of a list node (NULL_INDEX if
+      the node is not promoted).
+    -----------------------------------------------------------------------*/
+
+    void findPredecessors(int target, int* preds, int* predPos) const;
+    /*----------------------------------------------------------------------
+      For each level 1..topLevel, find the last entry whose position is
+      <= target.
+
+      Precondition:  -1 <= target < size()
+      Postcondition: preds[l] / predPos[l] hold the entry and its position.
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+
+    const NodePool* listPool; // Pool holding the indexed list's nodes
+    BasicNodePool<IndexEntry, int, InterleavedLayout> entries; // Storage for skip list entries
+    int headNext[MAX_LEVEL]; // First entry on each level
+    int headWidth[MAX_LEVEL]; // Width from position -1 to the first entry
+    vector<int> promoted; // Level 1 entry of each list node, by node index
+    int topLevel; // Highest level that has entries
+    int mySize; // Length of the indexed list
+    unsigned int seed; // State of the level generator
+};
+
+#endif
@@ -0,0 +1,349 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ShardedList Implementation
+ *
+ * Description:
+ * This file implements a list split into shards by position range, each
+ * an ArrayBasedList on its own NodePool with its own worker thread that
+ * runs the shard's part of bulk loads and searches.
+ */
+
+#include "ShardedList.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+using namespace std;
+
+/*** Shard: one pool, the list on it and the thread working on it ***/
+struct ShardedList::Shard
+{
+    Shard(size_t capacity) : pool(capacity), list(&pool), task(0), stopping(false) {}
+
+    NodePool pool;           // Nodes of this shard only
+    ArrayBasedList list;     // Elements of this shard, in order
+    thread worker;           // Runs the shard's part of parallel operations
+    mutex lock;              // Guards task and stopping
+    condition_variable wake; // Signals a new task or stopping
+    condition_variable done; // Signals that the task has finished
+    const function<void(int)>* task; // Task to run, 0 when idle
+    bool stopping;           // Set when the list is destroyed
+};
+
+/* -----------------------------
+   workerLoop()
+   Purpose: Run the tasks posted to one shard until it is stopped.
+   Input: shard (Shard pointer), index (int)
+   Output: None
+   ----------------------------- */
+void ShardedList::workerLoop(Shard* shard, int index)
+{
+    unique_lock<mutex> guard(shard->lock);
+    while (true) {
+        shard->wake.wait(guard, [shard]() { return shard->task != 0 || shard->stopping; });
+        if (shard->stopping) {
+            return;
+        }
+        guard.unlock();
+        (*shard->task)(index); // Only this thread touches the shard now
+        guard.lock();
+        shard->task = 0;
+        shard->done.notify_one();
+    }
+}
+
+/* -----------------------------
+   Constructor
+   Purpose: Create the shards and start their workers.
+   Input: count (int), capacityPerShard (size_t)
+   Output: A new empty list
+   ----------------------------- */
+ShardedList::ShardedList(int count, size_t capacityPerShard)
+{
+    if (count < 1) {
+        count = 1;
+    }
+    for (int k = 0; k < count; k++) {
+        Shard* shard = new Shard(capacityPerShard);
+        shard->worker = thread(workerLoop, shard, k);
+        shards.push_back(shard);
+    }
+}
+
+/* -----------------------------
+   Destructor
+   Purpose: Stop and join the workers, then free the shards.
+   Input: None
+   Output: Frees all memory
+   ----------------------------- */
+ShardedList::~ShardedList()
+{
+    for (size_t k = 0; k < shards.size(); k++) {
+        {
+            lock_guard<mutex> guard(shards[k]->lock);
+            shards[k]->stopping = true;
+        }
+        shards[k]->wake.notify_one();
+        shards[k]->worker.join();
+        delete shards[k]; // List before pool, by member order
+    }
+}
+
+/* -----------------------------
+   empty()
+   Purpose: Check if the list is empty.
+   Input: None
+   Output: true if empty, false otherwise
+   ----------------------------- */
+bool ShardedList::empty() const
+{
+    for (size_t k = 0; k < shards.size(); k++) {
+        if (!shards[k]->list.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* -----------------------------
+   length()
+   Purpose: Return the number of elements in the list.
+   Input: None
+   Output: Sum of the shard lengths
+   ----------------------------- */
+int ShardedList::length() const
+{
+    int total = 0;
+    for (size_t k = 0; k < shards.size(); k++) {
+        total += shards[k]->list.length();
+    }
+    return total;
+}
+
+/* -----------------------------
+   locate()
+   Purpose: Map a list position to a shard and a position inside it.
+   Input: position (int, by reference), inserting (bool)
+   Output: Shard index; position made relative to that shard
+   ----------------------------- */
+int ShardedList::locate(int& position, bool inserting) const
+{
+    int last = int(shards.size()) - 1;
+    int shard = 0;
+    int slack = inserting ? 0 : 1; // An insert may go right after a shard's last item
+    while (shard < last && position > shards[shard]->list.length() - slack) {
+        position -= shards[shard]->list.length();
+        shard++;
+    }
+    if (inserting && shard < last && position == shards[shard]->list.length() &&
+        shards[shard + 1]->list.length() < shards[shard]->list.length()) {
+        shard++; // On a boundary: the front of the shorter next shard
+        position = 0;
+    }
+    return shard;
+}
+
+/* -----------------------------
+   insert()
+   Purpose: Insert a value at a given position.
+   Input: value (ElementType), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ShardedList::insert(const ElementType& value, int position)
+{
+    if (position < 0 || position > length()) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int shard = locate(position, true);
+    return shards[shard]->list.insert(value, position);
+}
+
+/* -----------------------------
+   remove()
+   Purpose: Remove the value at a given position.
+   Input: position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ShardedList::remove(int position)
+{
+    if (position < 0 || position >= length()) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int shard = locate(position, false);
+    return shards[shard]->list.remove(position);
+}
+
+/* -----------------------------
+   push_back()
+   Purpose: Append a value to the last shard.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ShardedList::push_back(const ElementType& value)
+{
+    return shards.back()->list.push_back(value);
+}
+
+/* -----------------------------
+   runOnAll()
+   Purpose: Run a task on every worker and wait for all of them.
+   Input: task (function of the shard index)
+   Output: task has run once per shard
+   ----------------------------- */
+void ShardedList::runOnAll(const function<void(int)>& task) const
+{
+    for (size_t k = 0; k < shards.size(); k++) {
+        {
+            lock_guard<mutex> guard(shards[k]->lock);
+            shards[k]->task = &task;
+        }
+        shards[k]->wake.notify_one();
+    }
+    for (size_t k = 0; k < shards.size(); k++) {
+        Shard* shard = shards[k];
+        unique_lock<mutex> guard(shard->lock);
+        shard->done.wait(guard, [shard]() { return shard->task == 0; });
+    }
+}
+
+/* -----------------------------
+   load()
+   Purpose: Replace the contents, building all shards in parallel.
+   Input: items (vector of ElementType)
+   Output: true if every item was stored, false otherwise
+   ----------------------------- */
+bool ShardedList::load(const vector<ElementType>& items)
+{
+    size_t count = shards.size();
+    vector<char> stored(count, 1);
+    runOnAll([&](int k) {
+        // Shard k takes items [n * k / count, n * (k + 1) / count)
+        size_t from = items.size() * k / count;
+        size_t to = items.size() * (k + 1) / count;
+        if (!shards[k]->list.assign(items.data() + from, to - from)) {
+            stored[k] = 0; // Error already printed
+        }
+    });
+
+    for (size_t k = 0; k < count; k++) {
+        if (!stored[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* -----------------------------
+   search()
+   Purpose: Search every shard in parallel for a value.
+   Input: value (ElementType)
+   Output: First position of value if found, -1 otherwise
+   ----------------------------- */
+int ShardedList::search(const ElementType& value) const
+{
+    vector<int> found(shards.size(), -1);
+    runOnAll([&](int k) { found[k] = shards[k]->list.search(value); });
+
+    // The hit in the earliest shard is the first in the list
+    int offset = 0;
+    for (size_t k = 0; k < shards.size(); k++) {
+        if (found[k] >= 0) {
+            return offset + found[k];
+        }
+        offset += shards[k]->list.length();
+    }
+    return -1; // Not found
+}
+
+/* -----------------------------
+   rebalance()
+   Purpose: Even out the shard lengths, keeping the order.
+   Input: None
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool ShardedList::rebalance()
+{
+    vector<ElementType> items;
+    items.reserve(length());
+    for (const_iterator it = begin(); it != end(); ++it) {
+        items.push_back(*it);
+    }
+    return load(items);
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Clear every shard.
+   Input: None
+   Output: List becomes empty
+   ----------------------------- */
+void ShardedList::clear()
+{
+    for (size_t k = 0; k < shards.size(); k++) {
+        shards[k]->list.clear();
+    }
+}
+
+/* -----------------------------
+   display()
+   Purpose: Print all elements in the list.
+   Input: None
+   Output: Elements printed in order
+   ----------------------------- */
+void ShardedList::display() const
+{
+    cout << "List: ";
+    for (const_iterator it = begin(); it != end(); ++it) {
+        cout << *it << " ";
+    }
+    cout << endl;
+}
+
+/* -----------------------------
+   shardCount() / shardLength() / shardList()
+   Purpose: Describe how the elements are spread over the shards.
+   Input: shard (int) for shardLength and shardList
+   Output: Number of shards, elements in a shard, list of a shard
+   ----------------------------- */
+int ShardedList::shardCount() const
+{
+    return int(shards.size());
+}
+
+int ShardedList::shardLength(int shard) const
+{
+    return shards[shard]->list.length();
+}
+
+const ArrayBasedList& ShardedList::shardList(int shard) const
+{
+    return shards[shard]->list;
+}
+
+/* -----------------------------
+   begin() / end()
+   Purpose: Iterators over the elements in list order.
+   Input: None
+   Output: First element / one past the last
+   ----------------------------- */
+ShardedList::const_iterator ShardedList::begin() const
+{
+    return const_iterator(this, 0, shards[0]->list.begin());
+}
+
+ShardedList::const_iterator ShardedList::end() const
+{
+    int last = int(shards.size()) - 1;
+    return const_iterator(this, last, shards[last]->list.end());
+}
+
+ShardedList::const_iterator ShardedList::cbegin() const
+{
+    return begin();
+}
+
+ShardedList::const_iterator ShardedList::cend() const
+{
+    return end();
+}
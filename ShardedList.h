@@ -0,0 +1,284 @@
+/*-- ShardedList.h ---------------------------------------------------------
+
+  This header file defines the class ShardedList, a list of ElementType
+  values split over several shards. Each shard is an ArrayBasedList on a
+  NodePool of its own and has a worker thread of its own, so the list is
+  not limited to the capacity of one pool, and operations that touch
+  every element run on all shards at once.
+
+  Shards hold ranges of positions: shard 0 holds the first elements,
+  shard 1 the next ones, and so on, and each shard knows its own length.
+  A position is turned into a shard and a position inside it by adding
+  up the shard lengths, which costs O(shards). So the list keeps the
+  positional operations and order of ArrayBasedList, and iterating it is
+  iterating the shards one after the other.
+
+  Basic operations are:
+    Constructor
+    Destructor
+    empty:Check if list is empty
+    insert:Insert an item at a position
+    remove:Delete an item at a position
+    push_back:Append an item
+    load:Replace the contents with several items, all shards in parallel
+    search:Find the position of a value, all shards in parallel
+    rebalance:Spread the elements evenly over the shards
+    display:Output the list
+    begin/end:Forward iterator over the items in list order
+    shardCount/shardLength:How the elements are spread
+
+  load() gives every shard an equal slice of the items and each worker
+  builds its shard from its slice with one ArrayBasedList::assign.
+  search() lets every worker search its shard and takes the hit in the
+  earliest shard, so it still returns the first position holding the
+  value. Both take about 1/shards of the time of one ArrayBasedList once
+  there are as many cores as shards.
+
+  insert() at the boundary of two shards puts the item in the shorter
+  one, so inserts spread out. Appends still go to the last shard, and
+  removes can leave shards uneven; rebalance() (O(n)) evens them out
+  again so that the parallel operations keep scaling.
+
+  One thread at a time uses the list; the workers only run while a
+  parallel operation waits for them, so single-element operations and
+  iteration run on the calling thread. A ShardedList owns its pools and
+  threads and cannot be copied.
+
+-------------------------------------------------------------------------*/
+
+#ifndef SHARDEDLIST_H
+#define SHARDEDLIST_H
+#include <string>
+#include "nodepool.h"
+#include "ArrayBasedList.h"
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+class ShardedList
+{
+public:
+    /*** const_iterator: forward iterator over the values of all shards ***/
+    class const_iterator
+    {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef ElementType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const ElementType* pointer;
+        typedef const ElementType& reference;
+
+        const_iterator() : list(0), shard(0) {}
+        const_iterator(const ShardedList* owner, int at, ArrayBasedList::const_iterator position)
+            : list(owner), shard(at), current(position)
+        {
+            skipEmpty();
+        }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+
+        const_iterator& operator++()
+        {
+            ++current;
+            skipEmpty();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return shard == other.shard && current == other.current;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        // At the end of a shard, move on to the start of the next one
+        void skipEmpty()
+        {
+            while (shard + 1 < list->shardCount() && current == list->shardList(shard).end()) {
+                shard++;
+                current = list->shardList(shard).begin();
+            }
+        }
+
+        const ShardedList* list;                // List iterated over
+        int shard;                              // Shard of the current item
+        ArrayBasedList::const_iterator current; // Item within the shard
+    };
+
+    typedef const_iterator iterator; // Values are changed through the list only
+
+    /******** Function Members ********/
+
+    ShardedList(int count, size_t capacityPerShard);
+    /*----------------------------------------------------------------------
+      Construct an empty list over count NodePools of capacityPerShard
+      nodes each, and start one worker thread per shard.
+
+      Precondition:  count >= 1 (fewer is taken as 1).
+      Postcondition: An empty list is created; the pools grow as needed.
+    -----------------------------------------------------------------------*/
+
+    ~ShardedList();
+    /*----------------------------------------------------------------------
+      Stop the workers and free the shards and their pools.
+
+      Precondition:  None
+      Postcondition: All threads are joined and all memory is freed.
+    -----------------------------------------------------------------------*/
+
+    bool empty() const;
+    /*----------------------------------------------------------------------
+      Check if the list is empty.
+
+      Precondition:  None
+      Postcondition: Returns true if every shard is empty.
+    -----------------------------------------------------------------------*/
+
+    int length() const;
+    /*----------------------------------------------------------------------
+      Return the number of elements in the list; O(shards).
+
+      Precondition:  None
+      Postcondition: Returns the sum of the shard lengths.
+    -----------------------------------------------------------------------*/
+
+    bool insert(const ElementType& value, int position);
+    /*----------------------------------------------------------------------
+      Insert a value at a given position.
+
+      Precondition:  0 <= position <= length().
+      Postcondition: value is at position; returns false (with an error)
+                     for an invalid position or a full pool.
+    -----------------------------------------------------------------------*/
+
+    bool remove(int position);
+    /*----------------------------------------------------------------------
+      Remove the value at a given position.
+
+      Precondition:  0 <= position < length().
+      Postcondition: The node is returned to its shard's pool.
+    -----------------------------------------------------------------------*/
+
+    bool push_back(const ElementType& value);
+    /*----------------------------------------------------------------------
+      Append a value to the last shard.
+
+      Precondition:  None
+      Postcondition: value is the last element.
+    -----------------------------------------------------------------------*/
+
+    bool load(const vector<ElementType>& items);
+    /*----------------------------------------------------------------------
+      Replace the contents with items, each worker building its shard
+      from an equal slice of them at the same time.
+
+      Precondition:  None
+      Postcondition: The list holds items in order, spread evenly;
+                     returns false (with an error) if a pool ran out.
+    -----------------------------------------------------------------------*/
+
+    int search(const ElementType& value) const;
+    /*----------------------------------------------------------------------
+      Search for a value, every worker searching its shard at once.
+
+      Precondition:  None
+      Postcondition: Returns the first position of value, -1 if absent.
+    -----------------------------------------------------------------------*/
+
+    bool rebalance();
+    /*----------------------------------------------------------------------
+      Spread the elements over the shards so their lengths differ by at
+      most one, keeping their order; O(n).
+
+      Precondition:  None
+      Postcondition: Returns false (with an error) if a pool ran out.
+    -----------------------------------------------------------------------*/
+
+    void clear();
+    /*----------------------------------------------------------------------
+      Clear every shard.
+
+      Precondition:  None
+      Postcondition: List is empty; the nodes are back in their pools.
+    -----------------------------------------------------------------------*/
+
+    void display() const;
+    /*----------------------------------------------------------------------
+      Display the contents of the list.
+
+      Precondition:  None
+      Postcondition: Outputs list elements in order to standard output.
+    -----------------------------------------------------------------------*/
+
+    int shardCount() const;
+    int shardLength(int shard) const;
+    /*----------------------------------------------------------------------
+      Return the number of shards, and the number of elements in one.
+
+      Precondition:  0 <= shard < shardCount() (shardLength).
+    -----------------------------------------------------------------------*/
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    /*----------------------------------------------------------------------
+      Iterators over the values in list order, shard after shard. An
+      iterator stays valid until the list changes.
+
+      Precondition:  None
+      Postcondition: begin() == end() for an empty list.
+    -----------------------------------------------------------------------*/
+
+    ShardedList(const ShardedList&) = delete;
+    ShardedList& operator=(const ShardedList&) = delete;
+
+private:
+    struct Shard;
+
+    const ArrayBasedList& shardList(int shard) const;
+    /*----------------------------------------------------------------------
+      Return the list of one shard.
+    -----------------------------------------------------------------------*/
+
+    int locate(int& position, bool inserting) const;
+    /*----------------------------------------------------------------------
+      Find the shard holding position and make position relative to it.
+
+      Precondition:  0 <= position < length(), or <= length() when
+                     inserting.
+      Postcondition: Returns the shard; at a boundary between two shards
+                     an insert goes to the shorter one.
+    -----------------------------------------------------------------------*/
+
+    static void workerLoop(Shard* shard, int index);
+    /*----------------------------------------------------------------------
+      Body of a worker thread: run each task posted to shard until the
+      list is destroyed.
+    -----------------------------------------------------------------------*/
+
+    void runOnAll(const function<void(int)>& task) const;
+    /*----------------------------------------------------------------------
+      Run task(shard) on every worker thread and wait for all of them.
+
+      Precondition:  task only touches its own shard.
+      Postcondition: Every worker has finished; what they wrote is
+                     visible to the caller.
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+
+    vector<Shard*> shards; // Pool, list and worker of every shard
+};
+
+#endif
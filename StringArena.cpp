@@ -0,0 +1,214 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Pool String Arena
+ *
+ * Description:
+ * This file implements StringArena: a bump allocator over one growing
+ * byte buffer, with an open addressing intern table whose entries are
+ * invalidated all at once by bumping a generation counter.
+ */
+
+#include "StringArena.h"
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Create an empty arena.
+   Input: None
+   Output: Arena with no bytes and an empty intern table
+   ----------------------------- */
+StringArena::StringArena()
+{
+    used = 0;
+    interned = 0;
+    generation = 1;
+    Slot empty = { 0, { 0, 0 }, 0 };
+    table.assign(16, empty);
+}
+
+/* -----------------------------
+   reserve()
+   Purpose: Make room for more characters.
+   Input: more (size_t)
+   Output: true if the arena can hold them
+   ----------------------------- */
+bool StringArena::reserve(size_t more)
+{
+    const size_t limit = numeric_limits<unsigned int>::max();
+    if (more > limit - used) {
+        cerr << "Error: String arena is full" << endl;
+        return false;
+    }
+    if (used + more > bytes.size()) {
+        size_t size = bytes.empty() ? 4096 : bytes.size();
+        while (size < used + more) {
+            size *= 2;
+        }
+        bytes.resize(size < limit ? size : limit); // Offsets survive the move
+    }
+    return true;
+}
+
+/* -----------------------------
+   store()
+   Purpose: Copy a value to the end of the arena.
+   Input: value (string_view)
+   Output: View of the copy
+   ----------------------------- */
+ArenaString StringArena::store(string_view value)
+{
+    ArenaString stored = { 0, 0 };
+    if (!reserve(value.size())) {
+        return stored;
+    }
+    if (!value.empty()) {
+        memcpy(&bytes[used], value.data(), value.size());
+    }
+    stored.offset = (unsigned int)used;
+    stored.length = (unsigned int)value.size();
+    used += value.size();
+    return stored;
+}
+
+/* -----------------------------
+   probe()
+   Purpose: Find the slot of a value in the intern table.
+   Input: value (string_view), hash (size_t)
+   Output: Slot holding value, or the free slot where it belongs
+   ----------------------------- */
+size_t StringArena::probe(string_view value, size_t hash) const
+{
+    size_t mask = table.size() - 1;
+    size_t slot = hash & mask;
+    while (table[slot].generation == generation) {
+        if (table[slot].hash == hash && view(table[slot].value) == value) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/* -----------------------------
+   rehash()
+   Purpose: Move the live entries into a larger table.
+   Input: newSize (size_t)
+   Output: Table resized, entries reinserted
+   ----------------------------- */
+void StringArena::rehash(size_t newSize)
+{
+    vector<Slot> old;
+    old.swap(table);
+
+    Slot empty = { 0, { 0, 0 }, 0 };
+    table.assign(newSize, empty);
+    size_t mask = newSize - 1;
+
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].generation != generation) {
+            continue; // Empty, or left over from before a reset
+        }
+        size_t slot = old[i].hash & mask;
+        while (table[slot].generation == generation) {
+            slot = (slot + 1) & mask;
+        }
+        table[slot] = old[i];
+    }
+}
+
+/* -----------------------------
+   intern()
+   Purpose: Store a value once and share its view.
+   Input: value (string_view)
+   Output: View of the single copy of value
+   ----------------------------- */
+ArenaString StringArena::intern(string_view value)
+{
+    if (2 * (interned + 1) > table.size()) {
+        rehash(table.size() * 2);
+    }
+
+    size_t h = hash<string_view>()(value);
+    size_t slot = probe(value, h);
+    if (table[slot].generation == generation) {
+        return table[slot].value; // Seen before: no bytes are added
+    }
+
+    ArenaString stored = store(value);
+    if (stored.length != value.size()) {
+        return stored; // Arena full
+    }
+    table[slot].hash = h;
+    table[slot].value = stored;
+    table[slot].generation = generation;
+    interned++;
+    return stored;
+}
+
+/* -----------------------------
+   lookup()
+   Purpose: Find an interned value without adding it.
+   Input: value (string_view), found (ArenaString&)
+   Output: true if value is interned
+   ----------------------------- */
+bool StringArena::lookup(string_view value, ArenaString& found) const
+{
+    size_t slot = probe(value, hash<string_view>()(value));
+    if (table[slot].generation != generation) {
+        return false;
+    }
+    found = table[slot].value;
+    return true;
+}
+
+/* -----------------------------
+   view()
+   Purpose: Characters of a stored value.
+   Input: value (ArenaString)
+   Output: string_view into the arena
+   ----------------------------- */
+string_view StringArena::view(ArenaString value) const
+{
+    if (value.length == 0) {
+        return string_view();
+    }
+    return string_view(&bytes[value.offset], value.length);
+}
+
+/* -----------------------------
+   reset()
+   Purpose: Forget every value in O(1).
+   Input: None
+   Output: Arena empty, memory kept
+   ----------------------------- */
+void StringArena::reset()
+{
+    used = 0;
+    interned = 0;
+    if (++generation == 0) {
+        // Wrapped: stale entries could look live again, so wipe them once
+        Slot empty = { 0, { 0, 0 }, 0 };
+        table.assign(table.size(), empty);
+        generation = 1;
+    }
+}
+
+/* -----------------------------
+   bytesUsed() / internedCount()
+   Purpose: Size of the arena.
+   Input: None
+   Output: Characters stored / values interned
+   ----------------------------- */
+size_t StringArena::bytesUsed() const
+{
+    return used;
+}
+
+size_t StringArena::internedCount() const
+{
+    return interned;
+}
@@ -0,0 +1,150 @@
+/*-- StringArena.h ---------------------------------------------------------
+
+  This header file defines StringArena, a bump arena for the characters
+  of string payloads, and ArenaString, the 8-byte (offset, length) view a
+  pool node stores instead of a string object.
+
+  store() copies a value's characters to the end of one growing byte
+  buffer and returns its view; no allocation is made per value, only
+  when the buffer doubles. intern() does the same for values it has not
+  seen yet and returns the earlier view for repeated ones, so equal
+  interned values have equal views and compare as two 32-bit words.
+  Views hold offsets, so they stay valid when the buffer moves; a view
+  is resolved to characters with view().
+
+  Bytes are never freed one by one: reset() forgets every value in O(1)
+  (the intern table is invalidated by a generation counter rather than
+  cleared), after which all earlier views are dangling. An arena holds at
+  most 4 GiB of characters.
+
+  Basic operations are:
+     store:Copy a value into the arena
+     intern:Copy a value once and return the same view for repeats
+     lookup:Find the view of an interned value without adding it
+     view:Characters of a view
+     reset:Drop every value in O(1)
+     bytesUsed/internedCount:Size of the arena
+
+-------------------------------------------------------------------------*/
+
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+using namespace std;
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*** ArenaString: a value stored in a StringArena ***/
+struct ArenaString
+{
+    unsigned int offset;// First character in the arena
+    unsigned int length;// Number of characters
+
+    // Equal views of one arena's interned values mean equal values
+    bool operator==(const ArenaString& other) const
+    {
+        return offset == other.offset && length == other.length;
+    }
+    bool operator!=(const ArenaString& other) const { return !(*this == other); }
+};
+
+class StringArena
+{
+public:
+    /***** Function Members *****/
+    StringArena();
+    /*----------------------------------------------------------------------
+     Construct an empty arena.
+
+     Precondition:  None
+     Postcondition: No bytes are used and nothing is interned.
+    -----------------------------------------------------------------------*/
+
+    ArenaString store(string_view value);
+    /*----------------------------------------------------------------------
+     Copy value to the end of the arena.
+
+     Precondition:  None
+     Postcondition: Returns its view; an error is printed and the empty
+                    view returned if the arena would pass 4 GiB.
+    -----------------------------------------------------------------------*/
+
+    ArenaString intern(string_view value);
+    /*----------------------------------------------------------------------
+     Return the view of an equal interned value, storing value first if
+     there is none.
+
+     Precondition:  None
+     Postcondition: Equal values interned since the last reset() get
+                    equal views.
+    -----------------------------------------------------------------------*/
+
+    bool lookup(string_view value, ArenaString& found) const;
+    /*----------------------------------------------------------------------
+     Find the view of an interned value without storing anything.
+
+     Precondition:  None
+     Postcondition: Returns true and sets found if value was interned.
+    -----------------------------------------------------------------------*/
+
+    string_view view(ArenaString value) const;
+    /*----------------------------------------------------------------------
+     Return the characters of a view.
+
+     Precondition:  value came from this arena since the last reset().
+     Postcondition: The result is valid until the arena next grows.
+    -----------------------------------------------------------------------*/
+
+    void reset();
+    /*----------------------------------------------------------------------
+     Forget every stored and interned value in O(1).
+
+     Precondition:  No view from this arena is used again.
+     Postcondition: bytesUsed() and internedCount() are 0; the memory is
+                    kept for reuse.
+    -----------------------------------------------------------------------*/
+
+    size_t bytesUsed() const;
+    size_t internedCount() const;
+    /*----------------------------------------------------------------------
+     Return the characters stored and the number of interned values.
+    -----------------------------------------------------------------------*/
+
+private:
+    /*** Slot: one entry of the intern table ***/
+    struct Slot
+    {
+        size_t hash;// Hash of the value
+        ArenaString value;// Its view
+        unsigned int generation;// Entry is live when equal to generation
+    };
+
+    bool reserve(size_t more);
+    /*----------------------------------------------------------------------
+     Make room for more characters, doubling the buffer as needed.
+
+     Precondition:  None
+     Postcondition: Returns false (with an error) past 4 GiB.
+    -----------------------------------------------------------------------*/
+
+    size_t probe(string_view value, size_t hash) const;
+    /*----------------------------------------------------------------------
+     Return the slot holding value, or the empty slot where it belongs.
+    -----------------------------------------------------------------------*/
+
+    void rehash(size_t newSize);
+    /*----------------------------------------------------------------------
+     Move the live entries into a table of newSize slots (a power of two).
+    -----------------------------------------------------------------------*/
+
+    /***** Data Members *****/
+    vector<char> bytes;// Characters of every value, back to back
+    size_t used;// Characters in use
+    vector<Slot> table;// Open addressing intern table
+    size_t interned;// Live entries of the table
+    unsigned int generation;// Current generation of the table
+};
+
+#endif
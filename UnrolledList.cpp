@@ -0,0 +1,556 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: UnrolledList Implementation
+ *
+ * Description:
+ * This file implements an unrolled linked list: each pool node holds a
+ * block of up to UNROLL_FACTOR elements, so the list follows one link
+ * per block. Full blocks are split on insert; blocks that fall below
+ * half full on remove borrow from or merge with the next block.
+ */
+
+#include "UnrolledList.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Initialize an empty list with a given external node pool.
+   Input: externalPool (pointer to UnrolledNodePool)
+   Output: A new empty list
+   ----------------------------- */
+UnrolledList::UnrolledList(UnrolledNodePool* externalPool)
+{
+    pool = externalPool;       // Node pool used for memory management
+    head = NULL_INDEX;         // No blocks yet
+    tail = NULL_INDEX;
+    mySize = 0;                // Start with empty list
+    blocks = 0;
+    fingerPos = -1;            // No position resolved yet
+    fingerBlock = NULL_INDEX;
+    fingerPrev = NULL_INDEX;
+}
+
+/* -----------------------------
+   Destructor
+   Purpose: Release all blocks back to the pool.
+   Input: None
+   Output: Frees all blocks
+   ----------------------------- */
+UnrolledList::~UnrolledList()
+{
+    clear();
+}
+
+/* -----------------------------
+   empty()
+   Purpose: Check if the list is empty.
+   Input: None
+   Output: true if empty, false otherwise
+   ----------------------------- */
+bool UnrolledList::empty() const
+{
+    return mySize == 0;
+}
+
+/* -----------------------------
+   length()
+   Purpose: Return the number of elements in the list.
+   Input: None
+   Output: Count of elements
+   ----------------------------- */
+int UnrolledList::length() const
+{
+    return mySize;
+}
+
+/* -----------------------------
+   blockCount()
+   Purpose: Return the number of blocks in the list.
+   Input: None
+   Output: Count of pool nodes used
+   ----------------------------- */
+int UnrolledList::blockCount() const
+{
+    return blocks;
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Return every block to the pool as one chain.
+   Input: None
+   Output: List becomes empty
+   ----------------------------- */
+void UnrolledList::clear()
+{
+    if (head != NULL_INDEX) {
+        pool->releaseChain(head, tail, blocks);
+    }
+    head = NULL_INDEX;
+    tail = NULL_INDEX;
+    mySize = 0;
+    blocks = 0;
+    fingerPos = -1;
+}
+
+/* -----------------------------
+   locate()
+   Purpose: Find the block holding a position.
+   Input: position (int)
+   Output: block, previous block and start position (by reference)
+   ----------------------------- */
+void UnrolledList::locate(int position, int& block, int& previous, int& start)
+{
+    int current = head;
+    int before = NULL_INDEX;
+    int at = 0;
+    if (fingerPos != -1 && fingerPos <= position) {
+        // Resume from the last resolved block
+        current = fingerBlock;
+        before = fingerPrev;
+        at = fingerPos;
+    }
+    while (at + pool->data(current).count <= position) {
+        at += pool->data(current).count;
+        before = current;
+        current = pool->next(current);
+    }
+
+    block = current;
+    previous = before;
+    start = at;
+    fingerPos = at;
+    fingerBlock = current;
+    fingerPrev = before;
+}
+
+/* -----------------------------
+   addBlock()
+   Purpose: Link a new empty block after another.
+   Input: previous (int, NULL_INDEX for the front)
+   Output: The new block, or NULL_INDEX if the pool is exhausted
+   ----------------------------- */
+int UnrolledList::addBlock(int previous)
+{
+    int block = pool->acquireNode();
+    if (block == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return NULL_INDEX;
+    }
+    pool->data(block).count = 0; // Items left by an earlier user stay unused
+
+    if (previous == NULL_INDEX) {
+        pool->next(block) = head;
+        head = block;
+    }
+    else {
+        pool->next(block) = pool->next(previous);
+        pool->next(previous) = block;
+    }
+    if (pool->next(block) == NULL_INDEX) {
+        tail = block;
+    }
+    blocks++;
+    return block;
+}
+
+/* -----------------------------
+   dropBlock()
+   Purpose: Unlink an empty block and release it.
+   Input: block, previous (int)
+   Output: Block returned to the pool
+   ----------------------------- */
+void UnrolledList::dropBlock(int block, int previous)
+{
+    int following = pool->next(block);
+    if (previous == NULL_INDEX) {
+        head = following;
+    }
+    else {
+        pool->next(previous) = following;
+    }
+    if (tail == block) {
+        tail = previous;
+    }
+    pool->releaseNode(block);
+    blocks--;
+    fingerPos = -1;
+}
+
+/* -----------------------------
+   makeRoom()
+   Purpose: Open a slot for a new element, splitting a full block.
+   Input: position (int), slot (int, set)
+   Output: Block of the slot, or NULL_INDEX if the pool is exhausted
+   ----------------------------- */
+int UnrolledList::makeRoom(int position, int& slot)
+{
+    if (position == mySize) {
+        // Appending: fill the tail block before starting a new one
+        if (tail == NULL_INDEX || pool->data(tail).count == UNROLL_FACTOR) {
+            if (addBlock(tail) == NULL_INDEX) {
+                return NULL_INDEX;
+            }
+        }
+        slot = pool->data(tail).count++;
+        mySize++;
+        return tail;
+    }
+
+    int block, previous, start;
+    locate(position, block, previous, start);
+    int offset = position - start;
+
+    if (pool->data(block).count == UNROLL_FACTOR) {
+        // Split: the upper half moves to a new block after this one
+        int added = addBlock(block);
+        if (added == NULL_INDEX) {
+            return NULL_INDEX;
+        }
+        UnrolledBlock& full = pool->data(block);
+        UnrolledBlock& upper = pool->data(added);
+        move(full.items + HALF, full.items + UNROLL_FACTOR, upper.items);
+        upper.count = UNROLL_FACTOR - HALF;
+        full.count = HALF;
+        if (offset > HALF) {
+            previous = block;
+            block = added;
+            start += HALF;
+            offset -= HALF;
+            fingerPos = start;
+            fingerBlock = block;
+            fingerPrev = previous;
+        }
+    }
+
+    UnrolledBlock& target = pool->data(block);
+    move_backward(target.items + offset, target.items + target.count, target.items + target.count + 1);
+    target.count++;
+    mySize++;
+    slot = offset;
+    return block;
+}
+
+/* -----------------------------
+   insert()
+   Purpose: Insert a value at a given position.
+   Input: value (ElementType), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool UnrolledList::insert(const ElementType& value, int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int slot;
+    int block = makeRoom(position, slot);
+    if (block == NULL_INDEX) {
+        return false;
+    }
+    pool->data(block).items[slot] = value;
+    return true;
+}
+
+/* -----------------------------
+   insert() (move)
+   Purpose: Insert a value at a given position by moving it in.
+   Input: value (ElementType rvalue), position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool UnrolledList::insert(ElementType&& value, int position)
+{
+    if (position < 0 || position > mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int slot;
+    int block = makeRoom(position, slot);
+    if (block == NULL_INDEX) {
+        return false;
+    }
+    pool->data(block).items[slot] = std::move(value);
+    return true;
+}
+
+/* -----------------------------
+   remove()
+   Purpose: Remove the element at a position and rebalance its block.
+   Input: position (int)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool UnrolledList::remove(int position)
+{
+    if (position < 0 || position >= mySize) {
+        cerr << "Error: Invalid position" << endl;
+        return false;
+    }
+    int block, previous, start;
+    locate(position, block, previous, start);
+    UnrolledBlock& current = pool->data(block);
+    int offset = position - start;
+    move(current.items + offset + 1, current.items + current.count, current.items + offset);
+    current.count--;
+    mySize--;
+
+    int following = pool->next(block);
+    if (current.count < HALF && following != NULL_INDEX) {
+        UnrolledBlock& neighbour = pool->data(following);
+        if (neighbour.count > HALF) {
+            // Borrow the neighbour's first element
+            current.items[current.count++] = std::move(neighbour.items[0]);
+            move(neighbour.items + 1, neighbour.items + neighbour.count, neighbour.items);
+            neighbour.count--;
+        }
+        else {
+            // Both at most half full: merge the neighbour into this block
+            move(neighbour.items, neighbour.items + neighbour.count, current.items + current.count);
+            current.count += neighbour.count;
+            neighbour.count = 0;
+            dropBlock(following, block);
+        }
+    }
+    if (current.count == 0) {
+        dropBlock(block, previous); // Only the last block can run empty
+    }
+    return true;
+}
+
+/* -----------------------------
+   push_back()
+   Purpose: Append a value to the tail block.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool UnrolledList::push_back(const ElementType& value)
+{
+    return insert(value, mySize);
+}
+
+bool UnrolledList::push_back(ElementType&& value)
+{
+    return insert(std::move(value), mySize);
+}
+
+/* -----------------------------
+   push_front()
+   Purpose: Insert a value before the first element.
+   Input: value (ElementType)
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool UnrolledList::push_front(const ElementType& value)
+{
+    return insert(value, 0);
+}
+
+bool UnrolledList::push_front(ElementType&& value)
+{
+    return insert(std::move(value), 0);
+}
+
+/* -----------------------------
+   pop_front()
+   Purpose: Remove the first element.
+   Input: None
+   Output: true if successful, false otherwise
+   ----------------------------- */
+bool UnrolledList::pop_front()
+{
+    return remove(0);
+}
+
+/* -----------------------------
+   search()
+   Purpose: Find the position of a value, block by block.
+   Input: value (ElementType)
+   Output: Position if found, -1 otherwise
+   ----------------------------- */
+int UnrolledList::search(const ElementType& value) const
+{
+    int start = 0;
+    for (int block = head; block != NULL_INDEX; block = pool->next(block)) {
+        const UnrolledBlock& current = pool->data(block);
+        for (int i = 0; i < current.count; i++) {
+            if (current.items[i] == value) {
+                return start + i;
+            }
+        }
+        start += current.count;
+    }
+    return -1; // Not found
+}
+
+/* -----------------------------
+   display()
+   Purpose: Print all elements in the list.
+   Input: None
+   Output: Elements printed in order
+   ----------------------------- */
+void UnrolledList::display() const
+{
+    cout << "List: ";
+    for (int block = head; block != NULL_INDEX; block = pool->next(block)) {
+        const UnrolledBlock& current = pool->data(block);
+        for (int i = 0; i < current.count; i++) {
+            cout << current.items[i] << " ";
+        }
+    }
+    cout << endl;
+}
+
+/* -----------------------------
+   begin() / end()
+   Purpose: Iterators over the elements in list order.
+   Input: None
+   Output: First element / one past the last
+   ----------------------------- */
+UnrolledList::iterator UnrolledList::begin()
+{
+    return iterator(this, head);
+}
+
+UnrolledList::iterator UnrolledList::end()
+{
+    return iterator(this, NULL_INDEX);
+}
+
+UnrolledList::const_iterator UnrolledList::begin() const
+{
+    return const_iterator(this, head);
+}
+
+UnrolledList::const_iterator UnrolledList::end() const
+{
+    return const_iterator(this, NULL_INDEX);
+}
+
+UnrolledList::const_iterator UnrolledList::cbegin() const
+{
+    return begin();
+}
+
+UnrolledList::const_iterator UnrolledList::cend() const
+{
+    return end();
+}
+
+/* -----------------------------
+   Copy Constructor
+   Purpose: Create a deep copy of another list.
+   Input: source (UnrolledList)
+   Output: A new list identical to source
+   ----------------------------- */
+UnrolledList::UnrolledList(const UnrolledList& source)
+{
+    pool = source.pool;
+    head = NULL_INDEX;
+    tail = NULL_INDEX;
+    mySize = 0;
+    blocks = 0;
+    fingerPos = -1;
+    fingerBlock = NULL_INDEX;
+    fingerPrev = NULL_INDEX;
+    copyBlocks(source);
+}
+
+/* -----------------------------
+   operator=
+   Purpose: Replace the contents with copies of source's elements.
+   Input: source (UnrolledList)
+   Output: *this updated to match source
+   ----------------------------- */
+UnrolledList& UnrolledList::operator=(const UnrolledList& source)
+{
+    if (this != &source) {
+        clear(); // Current blocks go back as one chain
+        copyBlocks(source);
+    }
+    return *this;
+}
+
+/* -----------------------------
+   Move Constructor
+   Purpose: Take over another list's blocks in O(1).
+   Input: source (UnrolledList rvalue)
+   Output: A list holding source's elements; source is empty
+   ----------------------------- */
+UnrolledList::UnrolledList(UnrolledList&& source) noexcept
+{
+    pool = source.pool;
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+    blocks = source.blocks;
+    fingerPos = -1;
+    fingerBlock = NULL_INDEX;
+    fingerPrev = NULL_INDEX;
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+    source.blocks = 0;
+    source.fingerPos = -1;
+}
+
+/* -----------------------------
+   operator= (move)
+   Purpose: Release the current blocks and take over source's.
+   Input: source (UnrolledList rvalue)
+   Output: *this holds source's elements; source is empty
+   ----------------------------- */
+UnrolledList& UnrolledList::operator=(UnrolledList&& source)
+{
+    if (this == &source) {
+        return *this;
+    }
+    if (pool != source.pool) {
+        return *this = static_cast<const UnrolledList&>(source); // Blocks cannot change pools
+    }
+
+    clear();
+    head = source.head;
+    tail = source.tail;
+    mySize = source.mySize;
+    blocks = source.blocks;
+
+    source.head = NULL_INDEX;
+    source.tail = NULL_INDEX;
+    source.mySize = 0;
+    source.blocks = 0;
+    source.fingerPos = -1;
+    return *this;
+}
+
+/* -----------------------------
+   copyBlocks()
+   Purpose: Copy source's blocks into one freshly acquired chain.
+   Input: source (UnrolledList)
+   Output: The empty list now equals source
+   ----------------------------- */
+void UnrolledList::copyBlocks(const UnrolledList& source)
+{
+    if (source.head == NULL_INDEX) {
+        return;
+    }
+    int last;
+    int first = pool->acquireNodes(source.blocks, last);
+    if (first == NULL_INDEX) {
+        cerr << "Error: Node pool exhausted" << endl;
+        return;
+    }
+
+    int from = source.head;
+    for (int current = first; current != NULL_INDEX; current = pool->next(current)) {
+        const UnrolledBlock& original = source.pool->data(from);
+        UnrolledBlock& copy = pool->data(current);
+        copy_n(original.items, original.count, copy.items);
+        copy.count = original.count;
+        from = source.pool->next(from);
+    }
+    head = first;
+    tail = last;
+    mySize = source.mySize;
+    blocks = source.blocks;
+}
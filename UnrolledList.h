@@ -0,0 +1,349 @@
+/*-- UnrolledList.h --------------------------------------------------------
+
+  This header file defines the class UnrolledList, an unrolled linked list
+  on a node pool. Each pool node holds an UnrolledBlock: up to
+  UNROLL_FACTOR elements in order, their count and (in the pool) one next
+  link. Walking the list follows one link per block instead of one per
+  element, and the link and pool bookkeeping are paid once per block.
+
+  Basic operations are the positional ones of ArrayBasedList:
+    Constructor
+    Destructor
+    empty:Check if list is empty
+    insert:Insert an item at a position (copied or moved in)
+    remove:Delete an item at a position
+    push_back:Append an item in O(1) using the tail block
+    push_front:Prepend an item
+    pop_front:Remove the first item
+    search:Find the position of a value
+    display:Output the list
+    begin/end:Forward iterators over the items
+    blockCount:Number of pool nodes in use
+
+  A block that is full when an item is inserted into it is split into
+  two half-full blocks. When a remove leaves a block less than half full
+  it takes an item from the next block, or is merged with it if that one
+  is at most half full too. So every block but the last is at least half
+  full, and a positional operation costs O(n / UNROLL_FACTOR) link hops
+  plus O(UNROLL_FACTOR) element moves inside one or two blocks. Appends
+  fill the tail block to the top before starting a new one.
+
+  Like ArrayBasedList the list caches the block it last resolved a
+  position to (the finger), so an operation at or after it resumes from
+  there. Copies are deep and take all their blocks from the pool at
+  once; moving is O(1) within one pool. An iterator stays valid until the
+  list changes.
+
+-------------------------------------------------------------------------*/
+
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+#include <string>
+#include "nodepool.h"
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+
+const int UNROLL_FACTOR = 16; // Elements per block of an UnrolledList.
+
+/*** UnrolledBlock: the elements kept in one pool node ***/
+struct UnrolledBlock
+{
+    int count;// Elements in use, items[0..count-1]
+    ElementType items[UNROLL_FACTOR];// Elements in list order
+
+    UnrolledBlock() : count(0) {}
+};
+
+typedef BasicNodePool<UnrolledBlock, int, SplitLayout> UnrolledNodePool;
+
+class UnrolledList
+{
+public:
+    /*** ListIterator: forward iterator over the values of a list ***/
+    template <typename Value, typename List>
+    class ListIterator
+    {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef ElementType value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        ListIterator() : list(0), block(NULL_INDEX), slot(0), used(0) {}
+        ListIterator(List* owner, int at)
+            : list(owner), block(at), slot(0),
+              used(at == NULL_INDEX ? 0 : owner->pool->data(at).count) {}
+
+        // iterator converts to const_iterator (not the other way)
+        template <typename OtherValue, typename OtherList>
+        ListIterator(const ListIterator<OtherValue, OtherList>& other)
+            : list(other.list), block(other.block), slot(other.slot), used(other.used) {}
+
+        reference operator*() const { return list->pool->data(block).items[slot]; }
+        pointer operator->() const { return &list->pool->data(block).items[slot]; }
+
+        ListIterator& operator++()
+        {
+            if (++slot == used) {
+                block = list->pool->next(block);
+                slot = 0;
+                used = (block == NULL_INDEX) ? 0 : list->pool->data(block).count;
+            }
+            return *this;
+        }
+
+        ListIterator operator++(int)
+        {
+            ListIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        template <typename OtherValue, typename OtherList>
+        bool operator==(const ListIterator<OtherValue, OtherList>& other) const
+        {
+            return block == other.block && slot == other.slot;
+        }
+
+        template <typename OtherValue, typename OtherList>
+        bool operator!=(const ListIterator<OtherValue, OtherList>& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        template <typename, typename> friend class ListIterator;
+
+        List* list; // List iterated over
+        int block;  // Current block, NULL_INDEX at end()
+        int slot;   // Element within the block
+        int used;   // Elements in the block
+    };
+
+    typedef ListIterator<ElementType, UnrolledList> iterator;
+    typedef ListIterator<const ElementType, const UnrolledList> const_iterator;
+
+    /******** Function Members ********/
+
+    UnrolledList(UnrolledNodePool* externalPool);
+    /*----------------------------------------------------------------------
+      Construct an UnrolledList using an external UnrolledNodePool.
+
+      Precondition:  externalPool points to a valid UnrolledNodePool object.
+      Postcondition: An empty list is created with no blocks.
+    -----------------------------------------------------------------------*/
+
+    ~UnrolledList();
+    /*----------------------------------------------------------------------
+     Destroy the list and return all blocks to the free list.
+
+     Precondition:  None
+     Postcondition: All blocks of the list are released to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool empty() const;
+    /*----------------------------------------------------------------------
+     Check if the list is empty.
+
+     Precondition:  None
+     Postcondition: Returns true if list is empty, false otherwise.
+    -----------------------------------------------------------------------*/
+
+    bool insert(const ElementType& value, int position);
+    bool insert(ElementType&& value, int position);
+    /*----------------------------------------------------------------------
+     Insert a value (copied or moved in) at a given position.
+
+     Precondition:  0 <= position <= current list length; node pool has
+                    space if a block must be added.
+     Postcondition: value is inserted at position; a full block is split.
+    -----------------------------------------------------------------------*/
+
+    bool remove(int position);
+    /*----------------------------------------------------------------------
+     Remove the element at a given position.
+
+     Precondition:  0 <= position < current list length.
+     Postcondition: The element is removed; blocks are rebalanced or
+                    merged and empty blocks returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    bool push_back(const ElementType& value);
+    bool push_back(ElementType&& value);
+    /*----------------------------------------------------------------------
+     Append a value at the end of the list in O(1).
+
+     Precondition:  node pool has space if the tail block is full.
+     Postcondition: value is the last element.
+    -----------------------------------------------------------------------*/
+
+    bool push_front(const ElementType& value);
+    bool push_front(ElementType&& value);
+    /*----------------------------------------------------------------------
+     Insert a value at the front of the list; same as insert(value, 0).
+    -----------------------------------------------------------------------*/
+
+    bool pop_front();
+    /*----------------------------------------------------------------------
+     Remove the first element of the list; same as remove(0).
+
+     Precondition:  List is not empty.
+    -----------------------------------------------------------------------*/
+
+    int search(const ElementType& value) const;
+    /*----------------------------------------------------------------------
+     Search for a value in the list.
+
+     Precondition:  None
+     Postcondition: Returns position of value if found, -1 otherwise.
+    -----------------------------------------------------------------------*/
+
+    void display() const;
+    /*----------------------------------------------------------------------
+     Display the contents of the list.
+
+     Precondition:  None
+     Postcondition: Outputs list elements in order to standard output.
+    -----------------------------------------------------------------------*/
+
+    int length() const;
+    /*----------------------------------------------------------------------
+      Return the number of elements in the list.
+
+      Precondition:  None
+      Postcondition: Returns the count of elements in all blocks.
+    -----------------------------------------------------------------------*/
+
+    int blockCount() const;
+    /*----------------------------------------------------------------------
+      Return the number of blocks (pool nodes) the list uses.
+
+      Precondition:  None
+      Postcondition: length() / blockCount() is the mean occupancy.
+    -----------------------------------------------------------------------*/
+
+    void clear();
+    /*----------------------------------------------------------------------
+      Clear the list and return all blocks to the pool.
+
+      Precondition:  None
+      Postcondition: List is empty and all blocks are released.
+    -----------------------------------------------------------------------*/
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    /*----------------------------------------------------------------------
+      Iterators over the elements in list order.
+
+      Precondition:  None
+      Postcondition: begin() == end() for an empty list.
+    -----------------------------------------------------------------------*/
+
+    /***** Copy constructor *****/
+    UnrolledList(const UnrolledList&);
+    /*----------------------------------------------------------------------
+     Copy constructor.
+
+     Precondition:  None
+     Postcondition: A new list on source's pool holds copies of its
+                    elements (empty, with an error, if the pool is full).
+    -----------------------------------------------------------------------*/
+
+    UnrolledList& operator=(const UnrolledList&);
+    /*----------------------------------------------------------------------
+     Assignment operator.
+
+     Precondition:  None
+     Postcondition: The current list is cleared and replaced with copies
+                    of source's elements taken from this list's pool.
+    -----------------------------------------------------------------------*/
+
+    /***** Move constructor *****/
+    UnrolledList(UnrolledList&& source) noexcept;
+    /*----------------------------------------------------------------------
+     Move constructor; O(1).
+
+     Precondition:  None
+     Postcondition: The new list holds source's blocks; source is empty.
+    -----------------------------------------------------------------------*/
+
+    UnrolledList& operator=(UnrolledList&& source);
+    /*----------------------------------------------------------------------
+     Move assignment.
+
+     Precondition:  None
+     Postcondition: The current blocks are released and source's taken
+                    over in O(1), leaving source empty. Lists on
+                    different pools cannot trade blocks: then this copies.
+    -----------------------------------------------------------------------*/
+
+private:
+    enum { HALF = UNROLL_FACTOR / 2 }; // Least occupancy kept by remove
+    static_assert(UNROLL_FACTOR >= 2, "A block must hold two elements to split");
+
+    void locate(int position, int& block, int& previous, int& start);
+    /*----------------------------------------------------------------------
+      Find the block holding position, walking from the finger or head.
+
+      Precondition:  0 <= position < mySize
+      Postcondition: block holds position, previous is the block before it
+                     (NULL_INDEX for head) and start is the position of
+                     its first element; the finger is moved there.
+    -----------------------------------------------------------------------*/
+
+    int addBlock(int previous);
+    /*----------------------------------------------------------------------
+      Take an empty block from the pool and link it after previous (at
+      the front for NULL_INDEX).
+
+      Precondition:  previous is a block of the list or NULL_INDEX.
+      Postcondition: Returns the block, or NULL_INDEX (with an error) if
+                     the pool is exhausted.
+    -----------------------------------------------------------------------*/
+
+    void dropBlock(int block, int previous);
+    /*----------------------------------------------------------------------
+      Unlink an empty block and return it to the pool.
+
+      Precondition:  previous is the block before block (NULL_INDEX for head).
+      Postcondition: The finger is forgotten.
+    -----------------------------------------------------------------------*/
+
+    int makeRoom(int position, int& slot);
+    /*----------------------------------------------------------------------
+      Open a slot for one new element at position, splitting a full block.
+
+      Precondition:  0 <= position <= mySize
+      Postcondition: Returns the block whose items[slot] receives the new
+                     element (already counted in mySize), or NULL_INDEX
+                     (with an error, list unchanged) if a block was needed
+                     and the pool is exhausted.
+    -----------------------------------------------------------------------*/
+
+    void copyBlocks(const UnrolledList& source);
+    /*----------------------------------------------------------------------
+      Fill an empty list with copies of source's blocks.
+
+      Precondition:  The list is empty.
+      Postcondition: The list equals source (empty on pool exhaustion).
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+
+    int head; // Index of first block in the list
+    int tail; // Index of last block in the list
+    UnrolledNodePool* pool; // Pointer to external node pool
+    int mySize; // Number of elements
+    int blocks; // Number of blocks
+    int fingerPos; // Position of the first element of fingerBlock, -1 if none
+    int fingerBlock; // Block last resolved
+    int fingerPrev; // Block before fingerBlock
+};
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ArrayBasedList Value Index
+ *
+ * Description:
+ * This file implements an open addressing hash table from element values
+ * to node indices. Linear probing keeps a lookup within a few adjacent
+ * slots, and backward shift deletion keeps the table free of tombstones.
+ */
+
+#include "ValueIndex.h"
+using namespace std;
+
+/* -----------------------------
+   Constructor
+   Purpose: Create an empty table sized from the pool.
+   Input: listPool (pointer to NodePool)
+   Output: Empty index
+   ----------------------------- */
+ValueIndex::ValueIndex(const NodePool* listPool)
+    : listPool(listPool)
+{
+    size_t size = 16;
+    while (size < 2 * listPool->capacity()) {
+        size <<= 1;
+    }
+    Slot empty = { NULL_INDEX, 0 };
+    table.assign(size, empty);
+    mask = size - 1;
+    count = 0;
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Empty every slot.
+   Input: None
+   Output: Index holds no nodes
+   ----------------------------- */
+void ValueIndex::clear()
+{
+    Slot empty = { NULL_INDEX, 0 };
+    table.assign(table.size(), empty);
+    count = 0;
+}
+
+/* -----------------------------
+   rehash()
+   Purpose: Move all nodes into a larger table.
+   Input: newSize (size_t)
+   Output: Table resized, nodes reinserted
+   ----------------------------- */
+void ValueIndex::rehash(size_t newSize)
+{
+    vector<Slot> old;
+    old.swap(table);
+
+    Slot empty = { NULL_INDEX, 0 };
+    table.assign(newSize, empty);
+    mask = newSize - 1;
+
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].node == NULL_INDEX) {
+            continue;
+        }
+        size_t slot = old[i].hash & mask;
+        while (table[slot].node != NULL_INDEX) {
+            slot = (slot + 1) & mask;
+        }
+        table[slot] = old[i];
+    }
+}
+
+/* -----------------------------
+   insert()
+   Purpose: Add a node under its current value.
+   Input: node (int)
+   Output: None
+   ----------------------------- */
+void ValueIndex::insert(int node)
+{
+    if (2 * (count + 1) > table.size()) {
+        rehash(table.size() * 2); // Pool grew past the table
+    }
+
+    size_t h = hasher(listPool->data(node));
+    size_t slot = h & mask;
+    while (table[slot].node != NULL_INDEX) {
+        slot = (slot + 1) & mask;
+    }
+    table[slot].node = node;
+    table[slot].hash = h;
+    count++;
+}
+
+/* -----------------------------
+   erase()
+   Purpose: Remove a node and close the gap it leaves.
+   Input: node (int)
+   Output: None
+   ----------------------------- */
+void ValueIndex::erase(int node)
+{
+    size_t h = hasher(listPool->data(node));
+    size_t slot = h & mask;
+    while (table[slot].node != node) {
+        if (table[slot].node == NULL_INDEX) {
+            return; // Not indexed
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // Backward shift: pull later entries of the cluster into the hole
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+    while (table[next].node != NULL_INDEX) {
+        size_t home = table[next].hash & mask;
+        // Move next into the hole unless its home lies in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table[hole].node = NULL_INDEX;
+    count--;
+}
+
+/* -----------------------------
+   startProbe()
+   Purpose: Begin enumerating the nodes that hold a value.
+   Input: value (ElementType)
+   Output: Probe positioned at the value's home slot
+   ----------------------------- */
+ValueIndex::Probe ValueIndex::startProbe(const ElementType& value) const
+{
+    Probe probe;
+    probe.hash = hasher(value);
+    probe.slot = probe.hash & mask;
+    return probe;
+}
+
+/* -----------------------------
+   findNext()
+   Purpose: Continue a probe to the next node holding value.
+   Input: value (ElementType), probe (Probe)
+   Output: Node index, or NULL_INDEX when the cluster ends
+   ----------------------------- */
+int ValueIndex::findNext(const ElementType& value, Probe& probe) const
+{
+    while (table[probe.slot].node != NULL_INDEX) {
+        const Slot& slot = table[probe.slot];
+        probe.slot = (probe.slot + 1) & mask;
+        if (slot.hash == probe.hash && listPool->data(slot.node) == value) {
+            return slot.node;
+        }
+    }
+    return NULL_INDEX;
+}
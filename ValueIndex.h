@@ -0,0 +1,111 @@
+/*-- ValueIndex.h ----------------------------------------------------------
+
+  This header file defines the class ValueIndex, an optional hash index
+  that ArrayBasedList can keep from element values to the indices of the
+  nodes holding them, so search() does not scan the whole list.
+
+  The table uses open addressing with linear probing. Each slot stores a
+  node index and the hash of that node's value, so probing compares
+  hashes and only touches a node's data when the hashes match. Deleting
+  shifts later slots back instead of leaving tombstones. The table is
+  sized from the NodePool (a list can never hold more nodes than its pool)
+  and doubles with the pool, keeping the load factor at or below 1/2.
+
+  Every node of the list has its own slot, so duplicate values are all
+  present; the list decides which of them comes first.
+
+  Basic operations are:
+    Constructor
+    insert:Add a node under its current value
+    erase:Remove a node
+    findNext:Step through the nodes holding a value
+    clear:Remove all nodes
+
+-------------------------------------------------------------------------*/
+
+#ifndef VALUEINDEX_H
+#define VALUEINDEX_H
+#include "nodepool.h"
+#include <functional>
+#include <vector>
+
+class ValueIndex
+{
+public:
+    /*** Probe: position of a findNext() walk through the table ***/
+    struct Probe
+    {
+        size_t hash; // Hash of the value looked up
+        size_t slot; // Next slot to examine
+    };
+
+    /******** Function Members ********/
+
+    ValueIndex(const NodePool* listPool);
+    /*----------------------------------------------------------------------
+      Construct an empty index for a list stored in listPool.
+
+      Precondition:  listPool points to the NodePool of the indexed list.
+      Postcondition: Table has 2 * capacity rounded up to a power of two.
+    -----------------------------------------------------------------------*/
+
+    void insert(int node);
+    /*----------------------------------------------------------------------
+      Add a node under the value it currently holds.
+
+      Precondition:  node's data is set and node is not yet in the index.
+      Postcondition: findNext() reports node for its value.
+    -----------------------------------------------------------------------*/
+
+    void erase(int node);
+    /*----------------------------------------------------------------------
+      Remove a node.
+
+      Precondition:  node's data is unchanged since insert(node).
+      Postcondition: node is no longer reported.
+    -----------------------------------------------------------------------*/
+
+    Probe startProbe(const ElementType& value) const;
+    int findNext(const ElementType& value, Probe& probe) const;
+    /*----------------------------------------------------------------------
+      Enumerate the nodes holding value: call startProbe() once, then
+      findNext() until it returns NULL_INDEX.
+
+      Precondition:  probe came from startProbe(value).
+      Postcondition: Returns the next node holding value, or NULL_INDEX.
+    -----------------------------------------------------------------------*/
+
+    void clear();
+    /*----------------------------------------------------------------------
+      Remove all nodes.
+
+      Precondition:  None
+      Postcondition: The index is empty.
+    -----------------------------------------------------------------------*/
+
+private:
+    /*** Slot: one table entry ***/
+    struct Slot
+    {
+        int node;    // Node index, or NULL_INDEX if the slot is empty
+        size_t hash; // Hash of the node's value
+    };
+
+    void rehash(size_t newSize);
+    /*----------------------------------------------------------------------
+      Move every node into a table of newSize slots.
+
+      Precondition:  newSize is a power of two larger than 2 * count.
+      Postcondition: Table has newSize slots with the same nodes.
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+
+    const NodePool* listPool; // Pool holding the indexed list's nodes
+    vector<Slot> table; // Open addressing table, size is a power of two
+    size_t mask; // table.size() - 1
+    size_t count; // Number of nodes in the table
+    hash<ElementType> hasher; // Hash function for values
+};
+
+#endif
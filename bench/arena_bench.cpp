@@ -0,0 +1,124 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: String Arena Benchmark
+ *
+ * Description:
+ * This program compares ArrayBasedList (a string object per node) with
+ * ArenaStringList (an interned view into the pool's StringArena) on n
+ * appended values drawn from d distinct strings long enough to defeat
+ * the small string optimization: building the list, searching for an
+ * absent and a present value, and clearing the pool. Building is timed
+ * on a fresh pool and again after pool.clear(), with the calls to
+ * operator new made by each.
+ *
+ * Build: g++ -O2 -std=c++17 -I.. arena_bench.cpp ../ArrayBasedList.cpp ../ArenaStringList.cpp ../StringArena.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o arena_bench
+ * Usage: arena_bench [n] [d]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "../ArrayBasedList.h"
+#include "../ArenaStringList.h"
+using namespace std;
+
+volatile long sink; // Keeps results alive under optimization
+static long allocations = 0; // Calls to operator new
+
+void* operator new(size_t size)
+{
+    allocations++;
+    void* block = malloc(size ? size : 1);
+    if (block == 0) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void operator delete(void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+
+/* -----------------------------
+   millisSince()
+   Purpose: Elapsed time since start.
+   Input: start (time point)
+   Output: Milliseconds
+   ----------------------------- */
+double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/* -----------------------------
+   run()
+   Purpose: Time every operation on one kind of list.
+   Input: name (string), pool, values, n (size_t)
+   Output: CSV rows on standard output
+   ----------------------------- */
+template <typename List, typename Pool>
+void run(const string& name, Pool& pool, const vector<string>& values, size_t n)
+{
+    typedef chrono::steady_clock Clock;
+    {
+        List cold(&pool); // Grows the pool (and arena) to size once
+        long before = allocations;
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < n; i++) {
+            cold.push_back(values[i % values.size()]);
+        }
+        double coldMs = millisSince(start);
+        cout << name << ",build_cold," << n << "," << coldMs << "," << allocations - before << endl;
+    }
+    pool.clear();
+
+    List list(&pool);
+    long before = allocations;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        list.push_back(values[i % values.size()]);
+    }
+    double buildMs = millisSince(start);
+    cout << name << ",build," << n << "," << buildMs << "," << allocations - before << endl;
+
+    start = Clock::now();
+    sink += list.search("absent-value-that-is-not-in-the-list");
+    cout << name << ",search_miss," << n << "," << millisSince(start) << ",0" << endl;
+
+    start = Clock::now();
+    sink += list.search(values[values.size() - 1]);
+    cout << name << ",search_hit," << n << "," << millisSince(start) << ",0" << endl;
+
+    list.clear();
+    start = Clock::now();
+    pool.clear();
+    cout << name << ",pool_clear," << n << "," << millisSince(start) << ",0" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    size_t d = argc > 2 ? size_t(atol(argv[2])) : 1000;
+    if (n < 1 || d < 1) {
+        cerr << "Error: n and d must be positive" << endl;
+        return 1;
+    }
+
+    vector<string> values;
+    for (size_t i = 0; i < d; i++) {
+        values.push_back("customer-record-" + to_string(i) + "-payload");
+    }
+
+    cout << "list,operation,n,ms,allocations" << endl;
+    {
+        NodePool pool(n);
+        run<ArrayBasedList>("ArrayBasedList", pool, values, n);
+    }
+    {
+        ArenaNodePool pool(n);
+        run<ArenaStringList>("ArenaStringList", pool, values, n);
+    }
+    return 0;
+}
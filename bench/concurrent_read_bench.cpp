@@ -0,0 +1,201 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Concurrent Reader Benchmark
+ *
+ * Description:
+ * This program runs one writer thread that inserts and removes values at
+ * random positions of an ArrayBasedList while reader threads search it
+ * and walk it from begin() to end(). It compares one external mutex
+ * around every call with enableConcurrentReaders(), where readers take
+ * no lock at all. Every value a reader sees is checked to be one the
+ * writer could have stored, so a reader landing on a recycled node shows
+ * up as an error, and the run fails if any is found. Before the runs it
+ * checks that handles to removed nodes are rejected at once in this mode.
+ *
+ * Build: g++ -O2 -std=c++17 -pthread -I.. concurrent_read_bench.cpp ../ArrayBasedList.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o concurrent_read_bench
+ * Usage: concurrent_read_bench [maxReaders] [milliseconds] [n]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ArrayBasedList.h"
+using namespace std;
+
+const int DISTINCT = 1000; // Values the writer draws from
+
+/*** Result: operations done by each side in one run ***/
+struct Result
+{
+    double readsPerSecond;  // Searches and walks by all readers
+    double writesPerSecond; // Inserts and removes by the writer
+    long errors;            // Values no writer stored
+};
+
+/* -----------------------------
+   wellFormed()
+   Purpose: Check that a value is one the writer stores.
+   Input: value (string)
+   Output: true if value is "value-<number below DISTINCT>"
+   ----------------------------- */
+bool wellFormed(const string& value)
+{
+    if (value.compare(0, 6, "value-") != 0 || value.size() == 6) {
+        return false;
+    }
+    return atoi(value.c_str() + 6) < DISTINCT;
+}
+
+/* -----------------------------
+   run()
+   Purpose: Let one writer and several readers share a list for a while.
+   Input: readers (int), millis (int), n (int), lockFree (bool)
+   Output: Read and write rates and the number of bad values seen
+   ----------------------------- */
+Result run(int readers, int millis, int n, bool lockFree)
+{
+    vector<string> values;
+    for (int i = 0; i < DISTINCT; i++) {
+        values.push_back("value-" + to_string(i));
+    }
+
+    NodePool pool(n);
+    ArrayBasedList list(&pool);
+    for (int i = 0; i < n; i++) {
+        list.push_back(values[i % DISTINCT]);
+    }
+    if (lockFree) {
+        list.enableConcurrentReaders();
+    }
+    mutex lock; // Only used by the locked run
+
+    atomic<bool> stop(false);
+    atomic<long> reads(0), errors(0);
+    vector<thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.push_back(thread([&, r]() {
+            mt19937 rng(r + 1);
+            long done = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                if (rng() % 4 != 0) {
+                    const string& wanted = values[rng() % DISTINCT];
+                    int found;
+                    if (lockFree) {
+                        found = list.search(wanted);
+                    }
+                    else {
+                        lock_guard<mutex> guard(lock);
+                        found = list.search(wanted);
+                    }
+                    if (found < -1) {
+                        errors++;
+                    }
+                }
+                else {
+                    // Walk the whole list, checking every value on the way
+                    unique_lock<mutex> guard(lock, defer_lock);
+                    if (!lockFree) {
+                        guard.lock();
+                    }
+                    ArrayBasedList::ReadGuard reading(list);
+                    for (ArrayBasedList::const_iterator it = list.cbegin(); it != list.cend(); ++it) {
+                        if (!wellFormed(*it)) {
+                            errors++;
+                        }
+                    }
+                }
+                done++;
+            }
+            reads += done;
+        }));
+    }
+
+    mt19937 rng(0);
+    long writes = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point end = start + chrono::milliseconds(millis);
+    for (; chrono::steady_clock::now() < end; writes++) {
+        unique_lock<mutex> guard(lock, defer_lock);
+        if (!lockFree) {
+            guard.lock();
+        }
+        // Keep the length near n: remove when above, insert when below
+        if (list.length() > n || (list.length() == n && rng() % 2 == 0)) {
+            list.remove(int(rng() % list.length()));
+        }
+        else {
+            list.insert(values[rng() % DISTINCT], int(rng() % (list.length() + 1)));
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    stop.store(true);
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    Result result = { reads.load() / seconds, writes / seconds, errors.load() };
+    return result;
+}
+
+/* -----------------------------
+   handlesGoStale()
+   Purpose: Check that a removed node's handles are rejected at once in
+            concurrent reader mode, not only after its grace period.
+   Input: None
+   Output: true if every removal made its handle stale
+   ----------------------------- */
+bool handlesGoStale()
+{
+    NodePool pool(16);
+    ArrayBasedList list(&pool);
+    NodeHandle a = list.insertHandle("a", 0);
+    NodeHandle b = list.insertAfter(a, "b");
+    NodeHandle c = list.insertAfter(b, "c");
+    NodeHandle d = list.insertAfter(c, "d");
+    list.enableConcurrentReaders();
+
+    bool ok = list.removeAfter(a) && !list.isValid(b); // erase_after
+    ok = ok && list.remove(1) && !list.isValid(c);     // remove
+    list.remove_if([](const ElementType& value) { return value == "d"; });
+    ok = ok && !list.isValid(d);                       // remove_if
+    list.clear();
+    ok = ok && !list.isValid(a);                       // clear
+    return ok && list.length() == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int maxReaders = argc > 1 ? atoi(argv[1]) : int(thread::hardware_concurrency());
+    int millis = argc > 2 ? atoi(argv[2]) : 500;
+    int n = argc > 3 ? atoi(argv[3]) : 1000;
+    if (maxReaders < 1 || millis < 1 || n < 1) {
+        cerr << "Error: maxReaders, milliseconds and n must be positive" << endl;
+        return 1;
+    }
+
+    if (!handlesGoStale()) {
+        cerr << "Error: A handle to a removed node was still valid" << endl;
+        return 1;
+    }
+
+    long errors = 0;
+    cout << "readers,locked_reads_per_s,locked_writes_per_s,epoch_reads_per_s,epoch_writes_per_s" << endl;
+    for (int readers = 1; readers <= maxReaders; readers *= 2) {
+        Result locked = run(readers, millis, n, false);
+        Result epoch = run(readers, millis, n, true);
+        errors += locked.errors + epoch.errors;
+        cout << readers << "," << locked.readsPerSecond << "," << locked.writesPerSecond << ","
+             << epoch.readsPerSecond << "," << epoch.writesPerSecond << endl;
+    }
+    if (errors != 0) {
+        cerr << "Error: Readers saw " << errors << " values that were never stored" << endl;
+        return 1;
+    }
+    return 0;
+}
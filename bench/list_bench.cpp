@@ -0,0 +1,351 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ArrayBasedList Benchmark Suite
+ *
+ * Description:
+ * This program times the operations of ArrayBasedList (on its NodePool)
+ * against std::list<string> and std::vector<string> holding the same
+ * values: building by push_back, insert/remove at the head, tail, middle
+ * and random positions, search for a present and an absent value, copy
+ * construction, assignment and clear. Sizes go from 1e2 up to maxSize in
+ * powers of ten. Positional operations alternate between a chunk of
+ * inserts and a chunk of removes (at most n/10 each) so the size stays
+ * within 10% of n, and operations that are O(n) per call run fewer
+ * times on large sizes to bound the total time. Results are written to
+ * standard output as CSV (default) or JSON, one row per container,
+ * operation and size.
+ *
+ * Build: g++ -O2 -std=c++17 -I.. list_bench.cpp ../ArrayBasedList.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o list_bench
+ * Usage: list_bench [maxSize] [csv|json] [opsPerRow]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include "../ArrayBasedList.h"
+using namespace std;
+
+const long STEP_BUDGET = 20000000; // Node visits allowed per O(n) row
+const int MIN_OPS = 10;            // Fewest calls timed per row
+
+volatile long sink; // Keeps results alive under optimization
+double clockNs;     // Cost of one clock read, taken off chunk timings
+
+/*** Result: one output row ***/
+struct Result
+{
+    string container;
+    string operation;
+    size_t size;
+    long ops;
+    double totalNs;
+};
+
+/* -----------------------------
+   value()
+   Purpose: The string stored at build position i.
+   Input: i (size_t)
+   Output: Distinct value for every i
+   ----------------------------- */
+string value(size_t i)
+{
+    return "v" + to_string(i);
+}
+
+/*** PoolListBench: ArrayBasedList on its own NodePool ***/
+class PoolListBench
+{
+public:
+    static const char* name() { return "ArrayBasedList"; }
+    PoolListBench(size_t n) : pool(2 * n + 16), list(&pool) {}
+
+    void push_back(const string& v) { list.push_back(v); }
+    void insert(const string& v, int pos) { list.insert(v, pos); }
+    void remove(int pos) { list.remove(pos); }
+    int search(const string& v) const { return list.search(v); }
+    int size() const { return list.length(); }
+    void clear() { list.clear(); }
+
+    double copy()
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ArrayBasedList* copied = new ArrayBasedList(list);
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        sink += copied->length();
+        delete copied;
+        return ns;
+    }
+
+    double assignTo()
+    {
+        ArrayBasedList target(&pool);
+        for (int i = 0; i < list.length(); i++) {
+            target.push_back("old");
+        }
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        target = list;
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        sink += target.length();
+        return ns;
+    }
+
+private:
+    NodePool pool;
+    ArrayBasedList list;
+};
+
+/*** StdBench: std::list or std::vector behind the same interface ***/
+template <typename Seq>
+class StdBench
+{
+public:
+    static const char* name();
+    StdBench(size_t) {}
+
+    void push_back(const string& v) { items.push_back(v); }
+    void insert(const string& v, int pos) { items.insert(at(pos), v); }
+    void remove(int pos) { items.erase(at(pos)); }
+    int search(const string& v) const
+    {
+        int position = 0;
+        for (typename Seq::const_iterator it = items.begin(); it != items.end(); ++it, ++position) {
+            if (*it == v) {
+                return position;
+            }
+        }
+        return -1;
+    }
+    int size() const { return int(items.size()); }
+    void clear() { items.clear(); }
+
+    double copy()
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Seq* copied = new Seq(items);
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        sink += long(copied->size());
+        delete copied;
+        return ns;
+    }
+
+    double assignTo()
+    {
+        Seq target(items.size(), string("old"));
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        target = items;
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        sink += long(target.size());
+        return ns;
+    }
+
+private:
+    typename Seq::iterator at(int pos)
+    {
+        // From the nearer end: O(distance) for std::list, O(1) for std::vector
+        int size = int(items.size());
+        if (pos > size / 2) {
+            typename Seq::iterator it = items.end();
+            advance(it, pos - size);
+            return it;
+        }
+        typename Seq::iterator it = items.begin();
+        advance(it, pos);
+        return it;
+    }
+
+    Seq items;
+};
+
+template <>
+const char* StdBench<list<string> >::name() { return "std::list"; }
+template <>
+const char* StdBench<vector<string> >::name() { return "std::vector"; }
+
+/*** Where a positional row inserts and removes ***/
+enum Where { AT_HEAD, AT_TAIL, AT_MIDDLE, AT_RANDOM };
+
+/* -----------------------------
+   positionFor()
+   Purpose: Pick the position of the next insert or remove.
+   Input: where (Where), size (int), insert (bool), random (unsigned)
+   Output: Valid position for the operation
+   ----------------------------- */
+int positionFor(Where where, int size, bool insert, unsigned random)
+{
+    int limit = insert ? size + 1 : size; // Insert may append
+    switch (where) {
+    case AT_HEAD:
+        return 0;
+    case AT_TAIL:
+        return limit - 1;
+    case AT_MIDDLE:
+        return size / 2;
+    default:
+        return int(random % limit);
+    }
+}
+
+/* -----------------------------
+   opsFor()
+   Purpose: How many calls to time for an operation on n elements; any
+            row may be O(n) per call in one of the containers (even
+            remove at the tail of a singly linked list).
+   Input: n (size_t), maxOps (long)
+   Output: Number of calls
+   ----------------------------- */
+long opsFor(size_t n, long maxOps)
+{
+    long ops = STEP_BUDGET / long(n);
+    return max(long(MIN_OPS), min(ops, maxOps));
+}
+
+/* -----------------------------
+   runContainer()
+   Purpose: Time every operation of one container at one size.
+   Input: n (size_t), maxOps (long), results (vector of Result)
+   Output: Rows appended to results
+   ----------------------------- */
+template <typename Bench>
+void runContainer(size_t n, long maxOps, vector<Result>& results)
+{
+    typedef chrono::steady_clock Clock;
+    mt19937 rng(12345);
+    Bench bench(n);
+    string name = Bench::name();
+
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        bench.push_back(value(i));
+    }
+    Result build = { name, "build", n, long(n),
+                     chrono::duration<double, nano>(Clock::now() - start).count() };
+    results.push_back(build);
+
+    const char* names[] = { "head", "tail", "middle", "random" };
+    for (int w = AT_HEAD; w <= AT_RANDOM; w++) {
+        Where where = Where(w);
+        long ops = opsFor(n, maxOps);
+        vector<unsigned> draws(2 * ops);
+        for (long k = 0; k < 2 * ops; k++) {
+            draws[k] = unsigned(rng());
+        }
+
+        long chunk = max(1L, min(ops, long(n / 10)));
+        double insertNs = 0, removeNs = 0;
+        for (long k = 0; k < ops; k += chunk) {
+            long end = min(ops, k + chunk);
+            Clock::time_point a = Clock::now();
+            for (long j = k; j < end; j++) {
+                bench.insert("new", positionFor(where, bench.size(), true, draws[2 * j]));
+            }
+            Clock::time_point b = Clock::now();
+            for (long j = k; j < end; j++) {
+                bench.remove(positionFor(where, bench.size(), false, draws[2 * j + 1]));
+            }
+            Clock::time_point c = Clock::now();
+            insertNs += chrono::duration<double, nano>(b - a).count() - clockNs;
+            removeNs += chrono::duration<double, nano>(c - b).count() - clockNs;
+        }
+        insertNs = max(0.0, insertNs);
+        removeNs = max(0.0, removeNs);
+        Result ins = { name, string("insert_") + names[w], n, ops, insertNs };
+        Result rem = { name, string("remove_") + names[w], n, ops, removeNs };
+        results.push_back(ins);
+        results.push_back(rem);
+    }
+
+    long ops = opsFor(n, maxOps);
+    vector<string> targets(ops);
+    for (long k = 0; k < ops; k++) {
+        targets[k] = value(rng() % n);
+    }
+    start = Clock::now();
+    for (long k = 0; k < ops; k++) {
+        sink += bench.search(targets[k]);
+    }
+    Result hit = { name, "search_hit", n, ops,
+                   chrono::duration<double, nano>(Clock::now() - start).count() };
+    results.push_back(hit);
+
+    start = Clock::now();
+    for (long k = 0; k < ops; k++) {
+        sink += bench.search("absent");
+    }
+    Result miss = { name, "search_miss", n, ops,
+                    chrono::duration<double, nano>(Clock::now() - start).count() };
+    results.push_back(miss);
+
+    Result copied = { name, "copy", n, 1, bench.copy() };
+    results.push_back(copied);
+    Result assigned = { name, "assign", n, 1, bench.assignTo() };
+    results.push_back(assigned);
+
+    start = Clock::now();
+    bench.clear();
+    Result cleared = { name, "clear", n, 1,
+                       chrono::duration<double, nano>(Clock::now() - start).count() };
+    results.push_back(cleared);
+}
+
+/* -----------------------------
+   printResults()
+   Purpose: Write the rows as CSV or JSON.
+   Input: results (vector of Result), json (bool)
+   Output: Rows on standard output
+   ----------------------------- */
+void printResults(const vector<Result>& results, bool json)
+{
+    if (!json) {
+        cout << "container,operation,size,ops,total_ns,ns_per_op" << endl;
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            cout << r.container << "," << r.operation << "," << r.size << ","
+                 << r.ops << "," << long(r.totalNs) << "," << r.totalNs / r.ops << endl;
+        }
+        return;
+    }
+
+    cout << "[" << endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        cout << "  {\"container\": \"" << r.container << "\", \"operation\": \"" << r.operation
+             << "\", \"size\": " << r.size << ", \"ops\": " << r.ops
+             << ", \"total_ns\": " << long(r.totalNs) << ", \"ns_per_op\": " << r.totalNs / r.ops
+             << "}" << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    cout << "]" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t maxSize = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    bool json = argc > 2 && strcmp(argv[2], "json") == 0;
+    long maxOps = argc > 3 ? atol(argv[3]) : 1000;
+    if (maxOps < 1) {
+        maxOps = 1;
+    }
+
+    // Calibrate the clock once
+    const int READS = 100000;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < READS; i++) {
+        sink += long(chrono::steady_clock::now().time_since_epoch().count() & 1);
+    }
+    clockNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / READS;
+
+    vector<Result> results;
+    for (size_t n = 100; n <= maxSize; n *= 10) {
+        runContainer<PoolListBench>(n, maxOps, results);
+        runContainer<StdBench<list<string> > >(n, maxOps, results);
+        runContainer<StdBench<vector<string> > >(n, maxOps, results);
+    }
+    printResults(results, json);
+    return 0;
+}
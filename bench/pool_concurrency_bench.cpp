@@ -0,0 +1,196 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Concurrent NodePool Stress Test and Benchmark
+ *
+ * Description:
+ * This program first stress-tests a POOL_CONCURRENT NodePool: many
+ * threads acquire and release nodes at random while an ownership table
+ * checks that no index is ever handed to two threads at once, and the
+ * free list is verified to be whole at the end, once on the shared
+ * stack alone and once with per-thread magazines. It then measures
+ * acquire/release throughput of the lock-free free list, with and
+ * without magazines, against the same single-threaded pool guarded by
+ * a mutex.
+ *
+ * Build: g++ -O2 -std=c++17 -pthread -I.. pool_concurrency_bench.cpp -o pool_concurrency_bench
+ * Usage: pool_concurrency_bench [maxThreads] [opsPerThread]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../nodepool.h"
+using namespace std;
+
+const int HELD_PER_THREAD = 64; // Nodes a stress thread holds at most
+const int BATCH = 16;           // Acquires in a row per benchmark round
+const int MAGAZINE = 64;        // Magazine size of the magazine runs
+
+/*** MutexPool: the single-threaded pool behind one lock (baseline) ***/
+class MutexPool
+{
+public:
+    MutexPool(size_t capacity) : pool(capacity) {}
+    int acquireNode()
+    {
+        lock_guard<mutex> guard(lock);
+        return pool.acquireNode();
+    }
+    void releaseNode(int index)
+    {
+        lock_guard<mutex> guard(lock);
+        pool.releaseNode(index);
+    }
+
+private:
+    NodePool pool;
+    mutex lock;
+};
+
+/* -----------------------------
+   stressTest()
+   Purpose: Check exclusive ownership under concurrent acquire/release.
+   Input: threads (int), iterations per thread (int), magazine size
+   Output: true if no index was handed out twice and none was lost
+   ----------------------------- */
+bool stressTest(int threads, int iterations, int magazine)
+{
+    // Every thread may also cache a full magazine
+    const size_t maxNodes = size_t(threads) * (HELD_PER_THREAD + magazine);
+    NodePool pool(16, maxNodes, POOL_CONCURRENT); // Small start: forces growth
+    pool.setMagazineSize(magazine);
+    vector<atomic<int> > owner(maxNodes);
+    for (size_t i = 0; i < maxNodes; i++) {
+        owner[i].store(0);
+    }
+    atomic<long> violations(0);
+
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            mt19937 rng(t + 1);
+            vector<int> held;
+            for (int i = 0; i < iterations; i++) {
+                bool doAcquire = held.empty() ||
+                    (held.size() < size_t(HELD_PER_THREAD) && rng() % 2 == 0);
+                if (doAcquire) {
+                    int index = pool.acquireNode();
+                    if (index == NULL_INDEX) {
+                        violations++; // Pool sized for every held node
+                        continue;
+                    }
+                    if (owner[index].exchange(t + 1) != 0) {
+                        violations++; // Someone else already owns it
+                    }
+                    pool.next(index) = t; // Owned nodes may be written freely
+                    held.push_back(index);
+                }
+                else {
+                    size_t pick = rng() % held.size();
+                    int index = held[pick];
+                    held[pick] = held.back();
+                    held.pop_back();
+                    if (owner[index].exchange(0) != t + 1 || pool.next(index) != t) {
+                        violations++;
+                    }
+                    pool.releaseNode(index);
+                }
+            }
+            for (size_t i = 0; i < held.size(); i++) {
+                owner[held[i]].store(0);
+                pool.releaseNode(held[i]);
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+
+    // Every node must be back on the free list exactly once; the
+    // magazines of the finished threads were flushed when they exited.
+    // Taking the whole capacity as one chain must not need to grow.
+    size_t total = pool.capacity();
+    bool whole = pool.length() == 0;
+    int last;
+    int current = pool.acquireNodes(total, last);
+    whole = whole && current != NULL_INDEX && pool.capacity() == total;
+    vector<bool> seen(total, false);
+    for (; whole && current != NULL_INDEX; current = pool.next(current)) {
+        whole = !seen[current];
+        seen[current] = true;
+    }
+    cout << "stress: threads=" << threads << " magazine=" << magazine
+         << " capacity=" << pool.capacity()
+         << " violations=" << violations.load()
+         << " free_list_whole=" << (whole ? "yes" : "no") << endl;
+    return violations.load() == 0 && whole;
+}
+
+/* -----------------------------
+   throughput()
+   Purpose: Acquire/release rate of a pool shared by several threads.
+   Input: pool, threads (int), rounds per thread (int)
+   Output: Million operations per second (acquire + release)
+   ----------------------------- */
+template <typename Pool>
+double throughput(Pool& pool, int threads, int rounds)
+{
+    atomic<bool> go(false);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&]() {
+            int held[BATCH];
+            while (!go.load()) {
+                this_thread::yield();
+            }
+            for (int r = 0; r < rounds; r++) {
+                for (int b = 0; b < BATCH; b++) {
+                    held[b] = pool.acquireNode();
+                }
+                for (int b = 0; b < BATCH; b++) {
+                    pool.releaseNode(held[b]);
+                }
+            }
+        }));
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    go.store(true);
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return 2.0 * BATCH * rounds * threads / seconds / 1e6;
+}
+
+int main(int argc, char* argv[])
+{
+    int maxThreads = argc > 1 ? atoi(argv[1]) : int(thread::hardware_concurrency());
+    int ops = argc > 2 ? atoi(argv[2]) : 2000000;
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    int stressThreads = maxThreads < 8 ? 8 : maxThreads;
+    bool ok = stressTest(stressThreads, 200000, 0);
+    ok = stressTest(stressThreads, 200000, MAGAZINE) && ok;
+
+    cout << "threads,lockfree_mops,magazine_mops,mutex_mops" << endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        int rounds = ops / (2 * BATCH);
+        NodePool lockFree(size_t(threads) * BATCH, 0, POOL_CONCURRENT);
+        NodePool cached(size_t(threads) * (BATCH + MAGAZINE), 0, POOL_CONCURRENT);
+        cached.setMagazineSize(MAGAZINE);
+        MutexPool locked(size_t(threads) * BATCH);
+        double a = throughput(lockFree, threads, rounds);
+        double b = throughput(cached, threads, rounds);
+        double c = throughput(locked, threads, rounds);
+        cout << threads << "," << a << "," << b << "," << c << endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Persistent NodePool Benchmark
+ *
+ * Description:
+ * This program measures how long it takes to get a list of n strings
+ * back into a NodePool: by rebuilding it from the values (one chain
+ * built with assign), and by reopening a pool image written by sync().
+ * It also times sync() itself and reopening an image of trivially
+ * copyable payloads, which maps everything and decodes nothing.
+ *
+ * Build: g++ -O2 -std=c++17 -I.. pool_image_bench.cpp ../ArrayBasedList.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o pool_image_bench
+ * Usage: pool_image_bench [n] [imagePath]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../ArrayBasedList.h"
+using namespace std;
+
+typedef BasicNodePool<long long, int, SplitLayout> NumberPool;
+
+/* -----------------------------
+   millisSince()
+   Purpose: Elapsed time since start.
+   Input: start (time point)
+   Output: Milliseconds
+   ----------------------------- */
+double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    string path = argc > 2 ? argv[2] : "pool_image_bench.img";
+
+    vector<string> values(n);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = "value" + to_string(i);
+    }
+
+    cout << "operation,n,ms" << endl;
+    unlink(path.c_str());
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        NodePool pool(path, n);
+        ArrayBasedList list(&pool);
+        list.assign(values);
+        cout << "rebuild_strings," << n << "," << millisSince(start) << endl;
+
+        list.saveRoot(0);
+        start = chrono::steady_clock::now();
+        pool.sync();
+        cout << "sync_strings," << n << "," << millisSince(start) << endl;
+    }
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        NodePool pool(path);
+        ArrayBasedList list(&pool);
+        list.loadRoot(0);
+        cout << "reopen_strings," << n << "," << millisSince(start) << endl;
+        if (list.length() != int(n)) {
+            cerr << "Error: reopened list has " << list.length() << " nodes" << endl;
+            return 1;
+        }
+    }
+
+    unlink(path.c_str());
+    {
+        NumberPool pool(path, n);
+        int last;
+        int first = pool.acquireNodes(n, last);
+        for (int i = first; i != NULL_INDEX; i = pool.next(i)) {
+            pool.data(i) = i;
+        }
+        pool.setRoot(0, first, last, n);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        pool.sync();
+        cout << "sync_numbers," << n << "," << millisSince(start) << endl;
+    }
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        NumberPool pool(path);
+        cout << "reopen_numbers," << n << "," << millisSince(start) << endl;
+    }
+    unlink(path.c_str());
+    return 0;
+}
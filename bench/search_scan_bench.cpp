@@ -0,0 +1,133 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Payload Scan Search Benchmark
+ *
+ * Description:
+ * This program compares two ways of finding the position of a key in a
+ * list of n fixed-width keys whose nodes are shuffled over the pool:
+ * following the links and comparing each node's key (what search() does
+ * for string), and NodePool::findInChain, which scans the payload arrays
+ * with the kernels of PayloadScan.h and only walks links to turn a match
+ * into a position. Keys of 8 and 16 bytes are timed for a key that is
+ * absent and for one at a random position.
+ *
+ * Build: g++ -O2 -march=native -std=c++17 -I.. search_scan_bench.cpp -o search_scan_bench
+ * Usage: search_scan_bench [n] [searches]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../nodepool.h"
+using namespace std;
+
+volatile long sink; // Keeps results alive under optimization
+
+/*** Key16: a 16-byte identifier ***/
+struct Key16
+{
+    unsigned long long high;
+    unsigned long long low;
+    bool operator==(const Key16& other) const { return high == other.high && low == other.low; }
+};
+
+/* -----------------------------
+   makeKey()
+   Purpose: The key stored at list position i.
+   Input: i (size_t)
+   Output: Distinct key for every i
+   ----------------------------- */
+void makeKey(size_t i, unsigned long long& key) { key = i * 0x9E3779B97F4A7C15ULL + 1; }
+void makeKey(size_t i, Key16& key) { key.high = i; key.low = i * 0x9E3779B97F4A7C15ULL + 1; }
+
+/* -----------------------------
+   walkSearch()
+   Purpose: Find a key by following links and comparing every node.
+   Input: pool, head, key
+   Output: Position, or -1
+   ----------------------------- */
+template <typename Pool, typename Key>
+long walkSearch(const Pool& pool, int head, const Key& key)
+{
+    long position = 0;
+    for (int i = head; i != NULL_INDEX; i = pool.next(i)) {
+        if (pool.data(i) == key) {
+            return position;
+        }
+        position++;
+    }
+    return -1;
+}
+
+/* -----------------------------
+   run()
+   Purpose: Time both searches for one key type.
+   Input: name (string), n, searches (size_t)
+   Output: CSV rows on standard output
+   ----------------------------- */
+template <typename Key>
+void run(const string& name, size_t n, size_t searches)
+{
+    typedef BasicNodePool<Key, int, SplitLayout> Pool;
+    typedef chrono::steady_clock Clock;
+    Pool pool(n);
+    mt19937 rng(12345);
+
+    // Link the chain through a random permutation of the nodes
+    int last;
+    int head = pool.acquireNodes(n, last);
+    vector<int> order;
+    for (int i = head; i != NULL_INDEX; i = pool.next(i)) {
+        order.push_back(i);
+    }
+    shuffle(order.begin(), order.end(), rng);
+    for (size_t k = 0; k < n; k++) {
+        pool.next(order[k]) = (k + 1 < n) ? order[k + 1] : int(NULL_INDEX);
+        makeKey(k, pool.data(order[k]));
+    }
+    head = order[0];
+
+    Key absent;
+    makeKey(n + 1, absent);
+    vector<Key> present(searches);
+    for (size_t s = 0; s < searches; s++) {
+        makeKey(rng() % n, present[s]);
+    }
+
+    const char* cases[] = { "miss", "hit" };
+    for (int c = 0; c < 2; c++) {
+        Clock::time_point start = Clock::now();
+        for (size_t s = 0; s < searches; s++) {
+            sink += walkSearch(pool, head, c == 0 ? absent : present[s]);
+        }
+        double walkMs = chrono::duration<double, milli>(Clock::now() - start).count() / searches;
+
+        start = Clock::now();
+        for (size_t s = 0; s < searches; s++) {
+            sink += pool.findInChain(head, c == 0 ? absent : present[s]);
+        }
+        double scanMs = chrono::duration<double, milli>(Clock::now() - start).count() / searches;
+
+        cout << name << "," << cases[c] << "," << n << ",walk," << walkMs << endl;
+        cout << name << "," << cases[c] << "," << n << ",scan," << scanMs << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    size_t searches = argc > 2 ? size_t(atol(argv[2])) : 20;
+    if (n < 1 || searches < 1) {
+        cerr << "Error: n and searches must be positive" << endl;
+        return 1;
+    }
+
+    cout << "key,case,n,method,ms_per_search" << endl;
+    run<unsigned long long>("u64", n, searches);
+    run<Key16>("key16", n, searches);
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: ShardedList Scaling Benchmark
+ *
+ * Description:
+ * This program measures how ShardedList scales with the number of
+ * shards (one pool and one worker thread each). For 1, 2, 4, ... shards
+ * it times a parallel bulk load of n values and searches for an absent
+ * value, which every shard scans to the end, and prints the speedup over
+ * one ArrayBasedList on one pool doing the same work. The speedup can
+ * only follow the shard count up to the number of cores.
+ *
+ * Build: g++ -O2 -std=c++17 -pthread -I.. sharded_bench.cpp ../ShardedList.cpp ../ArrayBasedList.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o sharded_bench
+ * Usage: sharded_bench [maxShards] [n] [searches]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ShardedList.h"
+using namespace std;
+
+volatile long sink; // Keeps results alive under optimization
+
+/* -----------------------------
+   millisSince()
+   Purpose: Elapsed time since start.
+   Input: start (time point)
+   Output: Milliseconds
+   ----------------------------- */
+double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int maxShards = argc > 1 ? atoi(argv[1]) : int(thread::hardware_concurrency());
+    int n = argc > 2 ? atoi(argv[2]) : 1000000;
+    int searches = argc > 3 ? atoi(argv[3]) : 20;
+    if (maxShards < 1 || n < 1 || searches < 1) {
+        cerr << "Error: maxShards, n and searches must be positive" << endl;
+        return 1;
+    }
+
+    vector<ElementType> items;
+    for (int i = 0; i < n; i++) {
+        items.push_back("item-" + to_string(i));
+    }
+    const ElementType absent = "absent";
+    typedef chrono::steady_clock Clock;
+
+    // Baseline: one list on one pool, on the calling thread
+    double baseLoad, baseSearch;
+    {
+        NodePool pool(n);
+        ArrayBasedList list(&pool);
+        Clock::time_point start = Clock::now();
+        list.assign(items);
+        baseLoad = millisSince(start);
+        start = Clock::now();
+        for (int s = 0; s < searches; s++) {
+            sink += list.search(absent);
+        }
+        baseSearch = millisSince(start) / searches;
+    }
+
+    cout << "shards,load_ms,load_speedup,search_ms,search_speedup" << endl;
+    cout << "list," << baseLoad << ",1," << baseSearch << ",1" << endl;
+    for (int shards = 1; shards <= maxShards; shards *= 2) {
+        ShardedList list(shards, size_t(n / shards + 1));
+        Clock::time_point start = Clock::now();
+        if (!list.load(items)) {
+            return 1;
+        }
+        double loadMs = millisSince(start);
+        start = Clock::now();
+        for (int s = 0; s < searches; s++) {
+            sink += list.search(absent);
+        }
+        double searchMs = millisSince(start) / searches;
+        cout << shards << "," << loadMs << "," << baseLoad / loadMs << ","
+             << searchMs << "," << baseSearch / searchMs << endl;
+    }
+    return 0;
+}
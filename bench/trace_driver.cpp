@@ -0,0 +1,228 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Headless Trace Driver
+ *
+ * Description:
+ * This program replays an operation trace on an ArrayBasedList without
+ * any interaction or per-operation output, for load testing. The trace
+ * (see trace_gen.cpp for the format) is read from a file or standard
+ * input in large blocks and parsed completely before the replay starts,
+ * so reading it does not count towards the timings. Every operation is
+ * timed on its own; at the end the program prints the operations per
+ * second and, for each kind of operation, its count and latency
+ * percentiles in nanoseconds. An insert or remove whose position is out
+ * of range at replay time is counted as rejected and not run.
+ *
+ * Build: g++ -O2 -std=c++17 -I.. trace_driver.cpp ../ArrayBasedList.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o trace_driver
+ * Usage: trace_driver [trace file, or - for standard input] [pool capacity]
+ * Example: trace_gen ops=1000000 positions=back | trace_driver -
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../ArrayBasedList.h"
+using namespace std;
+
+const char KINDS[] = "irsc"; // Operation letters, in report order
+const char* const KIND_NAMES[] = { "insert", "remove", "search", "clear" };
+
+/*** TraceOp: one parsed line of the trace ***/
+struct TraceOp
+{
+    int kind;          // Index into KINDS
+    int position;      // Position of an insert or remove
+    ElementType value; // Value of an insert or search
+};
+
+/* -----------------------------
+   readAll()
+   Purpose: Read a whole file (or standard input) in large blocks.
+   Input: path ("-" for standard input), text (by reference)
+   Output: true if the input could be read
+   ----------------------------- */
+bool readAll(const char* path, string& text)
+{
+    FILE* input = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (input == 0) {
+        cerr << "Error: Cannot open " << path << endl;
+        return false;
+    }
+    static char block[1 << 20];
+    size_t got;
+    while ((got = fread(block, 1, sizeof(block), input)) > 0) {
+        text.append(block, got);
+    }
+    bool ok = !ferror(input);
+    if (input != stdin) {
+        fclose(input);
+    }
+    if (!ok) {
+        cerr << "Error: Cannot read " << path << endl;
+    }
+    return ok;
+}
+
+/* -----------------------------
+   parseTrace()
+   Purpose: Turn the text of a trace into operations.
+   Input: text (string), ops (by reference)
+   Output: true if every line was understood
+   ----------------------------- */
+bool parseTrace(const string& text, vector<TraceOp>& ops)
+{
+    size_t lineNumber = 0;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == string::npos) {
+            end = text.size();
+        }
+        lineNumber++;
+        string line = text.substr(start, end - start);
+        start = end + 1;
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        const char* kind = strchr(KINDS, line[0]);
+        TraceOp op;
+        op.kind = (kind == 0) ? -1 : int(kind - KINDS);
+        op.position = 0;
+        bool ok = op.kind >= 0 && (line.size() == 1 || line[1] == ' ');
+        const char* rest = line.c_str() + (line.size() > 1 ? 2 : 1);
+        if (ok && (op.kind == 0 || op.kind == 1)) {
+            // Position first, then (insert only) the value
+            char* after;
+            long position = strtol(rest, &after, 10);
+            ok = after != rest && position >= 0 && position <= 0x7fffffffL;
+            op.position = int(position);
+            rest = after;
+            if (ok && op.kind == 0) {
+                ok = *rest == ' ' && rest[1] != '\0';
+                rest++;
+            }
+            else if (ok) {
+                ok = *rest == '\0';
+            }
+        }
+        if (ok && (op.kind == 0 || op.kind == 2)) {
+            op.value = rest;
+            ok = !op.value.empty();
+        }
+        else if (ok && op.kind == 3) {
+            ok = line.size() == 1;
+        }
+        if (!ok) {
+            cerr << "Error: Line " << lineNumber << " is not a trace operation: " << line << endl;
+            return false;
+        }
+        ops.push_back(op);
+    }
+    return true;
+}
+
+/* -----------------------------
+   percentile()
+   Purpose: Nearest-rank percentile of sorted latencies.
+   Input: sorted (vector of nanoseconds), fraction (0 to 1)
+   Output: Latency at that rank, 0 if there are none
+   ----------------------------- */
+long long percentile(const vector<long long>& sorted, double fraction)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = size_t(fraction * sorted.size() + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+    return sorted[min(rank, sorted.size()) - 1];
+}
+
+int main(int argc, char* argv[])
+{
+    const char* path = argc > 1 ? argv[1] : "-";
+    size_t capacity = argc > 2 ? size_t(atol(argv[2])) : 1024;
+    if (capacity < 1) {
+        cerr << "Error: Pool capacity must be positive" << endl;
+        return 1;
+    }
+
+    string text;
+    vector<TraceOp> ops;
+    if (!readAll(path, text) || !parseTrace(text, ops)) {
+        return 1;
+    }
+    string().swap(text); // The replay only needs the parsed operations
+
+    NodePool pool(capacity);
+    ArrayBasedList list(&pool);
+    vector<long long> latency[4];
+    long rejected[4] = { 0, 0, 0, 0 };
+    long failed[4] = { 0, 0, 0, 0 };
+    long hits = 0;
+    for (int k = 0; k < 4; k++) {
+        latency[k].reserve(ops.size() / 4);
+    }
+
+    typedef chrono::steady_clock Clock;
+    Clock::time_point begin = Clock::now();
+    for (size_t i = 0; i < ops.size(); i++) {
+        const TraceOp& op = ops[i];
+        int length = list.length();
+        if ((op.kind == 0 && op.position > length) || (op.kind == 1 && op.position >= length)) {
+            rejected[op.kind]++; // Would only print an error
+            continue;
+        }
+
+        Clock::time_point start = Clock::now();
+        bool ok = true;
+        switch (op.kind) {
+        case 0:
+            ok = list.insert(op.value, op.position);
+            break;
+        case 1:
+            ok = list.remove(op.position);
+            break;
+        case 2:
+            hits += (list.search(op.value) >= 0);
+            break;
+        default:
+            list.clear();
+            break;
+        }
+        latency[op.kind].push_back(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count());
+        failed[op.kind] += !ok;
+    }
+    double seconds = chrono::duration<double>(Clock::now() - begin).count();
+
+    size_t executed = 0;
+    for (int k = 0; k < 4; k++) {
+        executed += latency[k].size();
+    }
+    cout << "operations," << ops.size() << '\n';
+    cout << "executed," << executed << '\n';
+    cout << "seconds," << seconds << '\n';
+    cout << "ops_per_second," << (seconds > 0 ? executed / seconds : 0.0) << '\n';
+    cout << "final_length," << list.length() << '\n';
+    cout << "search_hits," << hits << '\n';
+    cout << "operation,count,rejected,failed,p50_ns,p90_ns,p99_ns,p999_ns,max_ns" << '\n';
+    for (int k = 0; k < 4; k++) {
+        sort(latency[k].begin(), latency[k].end());
+        cout << KIND_NAMES[k] << "," << latency[k].size() << "," << rejected[k] << "," << failed[k] << ","
+             << percentile(latency[k], 0.50) << "," << percentile(latency[k], 0.90) << ","
+             << percentile(latency[k], 0.99) << "," << percentile(latency[k], 0.999) << ","
+             << percentile(latency[k], 1.0) << '\n';
+    }
+    cout.flush();
+    return 0;
+}
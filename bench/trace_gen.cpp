@@ -0,0 +1,174 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: Synthetic Trace Generator
+ *
+ * Description:
+ * This program writes an operation trace for trace_driver to standard
+ * output: one operation per line, in the format
+ *
+ *     i <position> <value>   insert value at position
+ *     r <position>           remove the value at position
+ *     s <value>              search for value
+ *     c                      clear the list
+ *
+ * Lines starting with # are comments. The mix of operations, where in
+ * the list inserts and removes land, how many distinct values there are
+ * and how often a search looks for a value the trace inserts are all set
+ * on the command line, so a trace can follow the shape of real traffic.
+ * The generator keeps track of the list length, so every position it
+ * writes is valid when the trace is replayed from the start on an empty
+ * list.
+ *
+ * Build: g++ -O2 -std=c++17 trace_gen.cpp -o trace_gen
+ * Usage: trace_gen [key=value ...]
+ *   ops=N             operations to write (default 1000000)
+ *   insert=W remove=W search=W clear=W
+ *                     relative weights of the operations (40 30 30 0)
+ *   positions=P       uniform, front or back (default uniform)
+ *   distinct=D        distinct values (default 10000)
+ *   hit=H             percent of searches for a value the trace inserts
+ *                     rather than one it never does (default 50)
+ *   seed=S            random seed (default 1)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+using namespace std;
+
+/*** TraceShape: what the command line asked for ***/
+struct TraceShape
+{
+    long ops;          // Operations to write
+    long weight[4];    // Weights of insert, remove, search, clear
+    string positions;  // uniform, front or back
+    long distinct;     // Distinct values
+    long hit;          // Percent of searches for an inserted value
+    unsigned long seed;// Random seed
+};
+
+/* -----------------------------
+   parseShape()
+   Purpose: Read key=value arguments into a TraceShape.
+   Input: argc, argv, shape (by reference)
+   Output: true if every argument was understood and valid
+   ----------------------------- */
+bool parseShape(int argc, char* argv[], TraceShape& shape)
+{
+    static const char* const names[4] = { "insert", "remove", "search", "clear" };
+    for (int a = 1; a < argc; a++) {
+        const char* equals = strchr(argv[a], '=');
+        if (equals == 0) {
+            cerr << "Error: Expected key=value, got " << argv[a] << endl;
+            return false;
+        }
+        string key(argv[a], equals - argv[a]);
+        const char* value = equals + 1;
+        bool known = false;
+        for (int k = 0; k < 4; k++) {
+            if (key == names[k]) {
+                shape.weight[k] = atol(value);
+                known = true;
+            }
+        }
+        if (key == "ops") {
+            shape.ops = atol(value);
+        }
+        else if (key == "positions") {
+            shape.positions = value;
+        }
+        else if (key == "distinct") {
+            shape.distinct = atol(value);
+        }
+        else if (key == "hit") {
+            shape.hit = atol(value);
+        }
+        else if (key == "seed") {
+            shape.seed = strtoul(value, 0, 10);
+        }
+        else if (!known) {
+            cerr << "Error: Unknown option " << key << endl;
+            return false;
+        }
+    }
+
+    long total = 0;
+    for (int k = 0; k < 4; k++) {
+        if (shape.weight[k] < 0) {
+            cerr << "Error: Weights must not be negative" << endl;
+            return false;
+        }
+        total += shape.weight[k];
+    }
+    if (total == 0 || shape.ops < 0 || shape.distinct < 1 || shape.hit < 0 || shape.hit > 100) {
+        cerr << "Error: Need a positive weight, ops >= 0, distinct >= 1 and 0 <= hit <= 100" << endl;
+        return false;
+    }
+    if (shape.positions != "uniform" && shape.positions != "front" && shape.positions != "back") {
+        cerr << "Error: positions must be uniform, front or back" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    TraceShape shape = { 1000000, { 40, 30, 30, 0 }, "uniform", 10000, 50, 1 };
+    if (!parseShape(argc, argv, shape)) {
+        return 1;
+    }
+
+    mt19937_64 rng(shape.seed);
+    discrete_distribution<int> pick(shape.weight, shape.weight + 4);
+    long length = 0; // List length after the operations so far
+    static char line[64];
+
+    printf("# trace_gen ops=%ld insert=%ld remove=%ld search=%ld clear=%ld positions=%s "
+           "distinct=%ld hit=%ld seed=%lu\n",
+           shape.ops, shape.weight[0], shape.weight[1], shape.weight[2], shape.weight[3],
+           shape.positions.c_str(), shape.distinct, shape.hit, shape.seed);
+    for (long op = 0; op < shape.ops; op++) {
+        int kind = pick(rng);
+        if (kind == 1 && length == 0) {
+            kind = 0; // Nothing to remove: insert instead
+        }
+
+        if (kind == 0 || kind == 1) {
+            // Position among the length + 1 insert (or length remove) slots
+            long slots = (kind == 0) ? length + 1 : length;
+            long position;
+            if (shape.positions == "front") {
+                position = 0;
+            }
+            else if (shape.positions == "back") {
+                position = slots - 1;
+            }
+            else {
+                position = long(rng() % slots);
+            }
+
+            if (kind == 0) {
+                snprintf(line, sizeof(line), "i %ld v%ld\n", position, long(rng() % shape.distinct));
+                length++;
+            }
+            else {
+                snprintf(line, sizeof(line), "r %ld\n", position);
+                length--;
+            }
+        }
+        else if (kind == 2) {
+            // Inserted values are v0.. and the others miss0..
+            const char* prefix = long(rng() % 100) < shape.hit ? "v" : "miss";
+            snprintf(line, sizeof(line), "s %s%ld\n", prefix, long(rng() % shape.distinct));
+        }
+        else {
+            length = 0;
+            snprintf(line, sizeof(line), "c\n");
+        }
+        fputs(line, stdout); // Buffered: no flush per line
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Assignment: UnrolledList Benchmark
+ *
+ * Description:
+ * This program compares ArrayBasedList (one element per pool node) with
+ * UnrolledList (UNROLL_FACTOR elements per node) on lists of n strings:
+ * building by push_back, inserting and removing at random positions
+ * (each one walks to its position), a full walk with iterators, a search
+ * for an absent value, and the pool nodes used.
+ *
+ * Build: g++ -O2 -std=c++17 -I.. unrolled_bench.cpp ../ArrayBasedList.cpp ../UnrolledList.cpp ../PositionIndex.cpp ../ValueIndex.cpp ../EpochReclaimer.cpp -o unrolled_bench
+ * Usage: unrolled_bench [n] [ops]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../ArrayBasedList.h"
+#include "../UnrolledList.h"
+using namespace std;
+
+volatile long sink; // Keeps results alive under optimization
+
+/* -----------------------------
+   millisSince()
+   Purpose: Elapsed time since start.
+   Input: start (time point)
+   Output: Milliseconds
+   ----------------------------- */
+double millisSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/* -----------------------------
+   run()
+   Purpose: Time every operation on one kind of list.
+   Input: name (string), list, pool, n, ops (size_t)
+   Output: CSV rows on standard output
+   ----------------------------- */
+template <typename List, typename Pool>
+void run(const string& name, List& list, Pool& pool, size_t n, size_t ops)
+{
+    typedef chrono::steady_clock Clock;
+    mt19937 rng(12345);
+
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        list.push_back("v" + to_string(i));
+    }
+    cout << name << ",build," << n << "," << millisSince(start) << endl;
+
+    start = Clock::now();
+    for (size_t k = 0; k < ops; k++) {
+        list.insert("new", int(rng() % (list.length() + 1)));
+        list.remove(int(rng() % list.length()));
+    }
+    cout << name << ",insert_remove_random," << ops << "," << millisSince(start) << endl;
+
+    start = Clock::now();
+    long characters = 0;
+    for (typename List::const_iterator it = list.begin(); it != list.end(); ++it) {
+        characters += long(it->size());
+    }
+    sink += characters;
+    cout << name << ",walk," << n << "," << millisSince(start) << endl;
+
+    start = Clock::now();
+    sink += list.search("absent");
+    cout << name << ",search_miss," << n << "," << millisSince(start) << endl;
+    cout << name << ",pool_nodes," << n << "," << pool.length() << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    size_t ops = argc > 2 ? size_t(atol(argv[2])) : 1000;
+    if (n < 1) {
+        cerr << "Error: n must be positive" << endl;
+        return 1;
+    }
+
+    cout << "list,operation,n,ms" << endl;
+    {
+        NodePool pool(n);
+        ArrayBasedList list(&pool);
+        run("ArrayBasedList", list, pool, n, ops);
+    }
+    {
+        UnrolledNodePool pool(n / UNROLL_FACTOR + 1);
+        UnrolledList list(&pool);
+        run("UnrolledList", list, pool, n, ops);
+    }
+    return 0;
+}
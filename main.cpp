@@ -6,10 +6,12 @@
  * This program provides an interactive menu to test the ArrayBasedList class.
  * It demonstrates list operations (insert, remove, search, display, clear)
  * while showing the state of the NodePool including the free list.
+ * For load testing without the menu and the dumps, replay a trace with
+ * bench/trace_driver.cpp (traces come from bench/trace_gen.cpp).
  */
 
 #include <iostream>
-#include "nodePool.h"
+#include "nodepool.h"
 #include "ArrayBasedList.h"
 
  // Function to display menu
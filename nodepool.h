@@ -1,23 +1,116 @@
 /*-- nodePool.h -------------------------------------------------------------
 
-  This header file defines the data types Node and NodePool for managing
-  a fixed-size array-based storage pool used in linked list implementations.
+  This header file defines the class templates BasicNode and BasicNodePool
+  for managing a growable array-based storage pool used in linked list
+  implementations.
 
-  The Node class represents individual nodes containing a data element and
-  an integer link to the next node. The NodePool class manages a static array
-  of Node objects and simulates dynamic memory allocation using a free list.
+  The BasicNode class represents individual nodes containing a data element
+  and an integer link to the next node. The BasicNodePool class manages
+  segments of Node objects and simulates dynamic memory allocation using a
+  free list. The pool takes its capacity at construction time and, when the
+  free list runs dry, grows by adding a new segment. Segments are never
+  moved or copied, so an index stays valid for the lifetime of the pool.
+
+  Segment 0 holds the initial capacity (rounded up to a power of two) and
+  every following segment doubles the total capacity:
+
+     segment 0: indices [0, base)
+     segment k: indices [base * 2^(k-1), base * 2^k)
+
+  How a segment stores its nodes is chosen by the Layout parameter:
+
+     InterleavedLayout: one array of BasicNode {data, next}
+     SplitLayout:       a dense array of next links beside a separate
+                        array of data (structure of arrays)
+     DoublyLinkedLayout: SplitLayout plus a dense array of prev links,
+                        for doubly linked lists
+
+  With SplitLayout a walk that only follows links reads sizeof(IndexT)
+  bytes per node instead of pulling whole data objects through the cache.
+  getNode() returns a NodeRef {data, next} of references in both layouts;
+  next() and data() access one field without the bounds check.
+
+  Node and NodePool are the instantiations used by ArrayBasedList. Every
+  list walk is link-only, so NodePool uses SplitLayout. DoublyNodePool is
+  used by DoublyLinkedList; its nodes carry the extra prev link, which is
+  why the singly linked pool does not use that layout.
+
+  A pool constructed with POOL_CONCURRENT can be shared by threads that
+  each own their lists. Its free list is a lock-free stack (Treiber stack)
+  over node indices: the head word packs the first free index with a
+  32-bit tag that changes on every push and pop, so a compare-and-swap
+  cannot succeed on a head that was popped and pushed back in between
+  (the ABA problem). Free-list links are kept in their own atomic array so
+  threads writing the next links of the nodes they own never race with
+  threads walking the free list. Growth is rare and serialized by a mutex.
+  In this mode acquireNode, releaseNode, grow, isFull, capacity and access
+  to nodes a thread owns are thread-safe; initializePool, clear, list,
+  length and displayFreeList expect the pool to be quiescent.
+
+  A concurrent pool can also give every thread a magazine: a small cache
+  of free indices that serves acquireNode and releaseNode without touching
+  the shared stack. An empty magazine is refilled with half a magazine of
+  nodes by one compare-and-swap, and a full one returns half of its nodes
+  the same way, so threads meet on the shared head once per batch instead
+  of once per node. A thread's magazines are flushed back when it exits.
+  Nodes cached by one thread are not handed to another, so a pool at its
+  maximum capacity can report full while other threads still cache nodes.
+
+  The pool counts the nodes that are off its free list, so length() no
+  longer walks the free list: it is O(1), or O(threads) when magazines
+  must be subtracted. Built with NODEPOOL_STATS (see PoolStats.h) it also
+  counts acquires, releases, failed acquires and its high-water mark, all
+  readable through stats() from any thread.
+
+  A pool can also live in a file (the "image"). The persistent constructor
+  maps every segment's links from the file with copy-on-write mappings, so
+  reopening a pool of millions of nodes only maps pages instead of relinking
+  them. Payloads that are trivially copyable are mapped the same way. Others
+  (such as string) cannot be mapped: sync() writes them to a payload arena
+  in the file through PayloadCodec, and reopening decodes them in one
+  sequential pass. The image is versioned and also stores the free-list
+  head and a few root slots where lists record their head, tail and size.
+  The file only changes in sync() (and on destruction, which syncs): a
+  checkpoint that was interrupted leaves the image marked unclean, and
+  such an image is refused on open. Persistent pools are single-threaded
+  and need a POSIX system.
+
+  A pool of ArenaString (see StringArena.h) owns a StringArena for the
+  characters of its payloads: nodes hold 8-byte (offset, length) views,
+  so storing a value copies its characters into the arena instead of
+  allocating, and clear() drops all of them in O(1). Such pools cannot
+  be persistent.
 
   Basic operations are:
      Node:Represents a single node with data and link index
      NodePool:Manages allocation and deallocation of nodes
      initializePool:Set up the free list
-     acquireNode:Allocate a node from the pool
+     acquireNode:Allocate a node from the pool (grows the pool if needed)
      releaseNode:Return a node to the pool
+     acquireNodes:Allocate a linked chain of nodes in one call
+     releaseChain:Return a linked chain of nodes in one call
+     compact:Renumber a chain's nodes into ascending order
+     sortFreeList:Relink the free list in ascending index order
      getNode:Access a node by index
+     next/data:Access one field of a node by index
+     loadNext/publishNext:Atomic link access for concurrent readers
+     emplace:Construct a node's data in place
+     findPayload/findInChain:Search the payload arrays sequentially
+     arena:Bytes of ArenaString payloads, reset by clear()
+     addReference/dropReference:Count lists sharing a node (copy-on-write)
+     handleOf/isValid/retire:Generational handles that detect stale indices
      displayFreeList: Show the current free list
      clear:Reset the pool
      list:Display all nodes
      length:Count used nodes
+     capacity:Number of nodes currently allocated
+     grow:Add a segment to the pool
+     setMagazineSize:Size of the per-thread caches of a concurrent pool
+     flushMagazine:Return the calling thread's cached nodes to the pool
+     stats:Snapshot of the pool's counters
+     resetStats:Restart the counters
+     sync:Write a consistent image of a persistent pool
+     setRoot/getRoot:Record where a list lives in the pool
 
 -----------------------------------------------------------------------------*/
 
@@ -27,24 +120,131 @@
 using namespace std;
 #include <iostream>
 #include <string>
-const int NUM_NODES = 10; // The capacity of the node pool.
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include "PoolStats.h"
+#include "PayloadScan.h"
+#include "StringArena.h"
+const int DEFAULT_CAPACITY = 10; // The initial capacity of a node pool.
 const int NULL_INDEX = -1;//value representing a null or invalid index.
+const int POOL_ROOTS = 16;// Root slots stored with a pool image.
+const unsigned int POOL_IMAGE_VERSION = 1;// Format of pool image files.
 typedef string ElementType;//Defines the type of data stored in each node.
 
-/*** Node class ***/
-class Node
+/*** PoolRoot: where one list lives in a pool ***/
+struct PoolRoot
+{
+    long long head;// Index of the first node, NULL_INDEX if empty
+    long long tail;// Index of the last node
+    unsigned long long count;// Number of nodes
+};
+
+/*** PoolImageHeader: first page of a pool image file ***/
+struct PoolImageHeader
+{
+    char magic[8];// "NODEPOOL"
+    unsigned int version;// POOL_IMAGE_VERSION
+    unsigned int indexBytes;// sizeof(IndexT)
+    unsigned int payloadBytes;// sizeof(T) if payloads are mapped, else 0
+    unsigned int layout;// PoolSegment::IMAGE_LAYOUT
+    unsigned int clean;// 1 once a sync() has completed
+    unsigned int regionAlign;// Segment regions start at multiples of this
+    int baseShift;// log2 of the size of segment 0
+    int segmentCount;// Segments stored in the file
+    unsigned long long capacity;// Nodes in all segments
+    unsigned long long maxNodes;// Capacity the pool may grow to
+    unsigned long long used;// Nodes off the free list
+    long long freePtr;// Head of the free list
+    unsigned long long arenaOffset;// File offset of the payload arena
+    unsigned long long arenaBytes;// Size of the payload arena
+    PoolRoot roots[POOL_ROOTS];// Lists recorded with setRoot()
+};
+
+/*** PayloadCodec: byte encoding of payloads that cannot be mapped ***/
+template <typename T>
+struct PayloadCodec
+{
+    static const bool AVAILABLE = false;// No encoding for T
+    static size_t size(const T&) { return 0; }
+    static char* write(const T&, char* out) { return out; }
+    static const char* read(const char*, const char*, T&) { return 0; }
+};
+
+template <>
+struct PayloadCodec<string>
+{
+    static const bool AVAILABLE = true;
+
+    // 4-byte length followed by the characters
+    static size_t size(const string& value) { return 4 + value.size(); }
+
+    static char* write(const string& value, char* out)
+    {
+        unsigned int length = (unsigned int)value.size();
+        memcpy(out, &length, 4);
+        memcpy(out + 4, value.data(), length);
+        return out + 4 + length;
+    }
+
+    static const char* read(const char* in, const char* end, string& value)
+    {
+        unsigned int length;
+        if (end - in < 4) {
+            return 0;
+        }
+        memcpy(&length, in, 4);
+        if (size_t(end - in - 4) < length) {
+            return 0; // Truncated arena
+        }
+        value.assign(in + 4, length);
+        return in + 4 + length;
+    }
+};
+
+/*** PayloadArena: storage a pool owns for the bytes of its payloads ***/
+template <typename T>
+struct PayloadArena
+{
+    struct None {};
+    typedef None Arena;// Payloads own their bytes
+    static const bool OWNED = false;
+};
+
+template <>
+struct PayloadArena<ArenaString>
+{
+    typedef StringArena Arena;// Characters of every node's view
+    static const bool OWNED = true;
+};
+
+/*** Free list synchronization of a pool ***/
+enum PoolConcurrency
+{
+    POOL_SINGLE_THREADED,// Plain free list through next links
+    POOL_CONCURRENT      // Lock-free tagged free list, shareable by threads
+};
+
+/*** BasicNode class template ***/
+template <typename T, typename IndexT = int>
+class BasicNode
 {
 public:
     /***** Constructors *****/
-    Node();
+    BasicNode();
     /*----------------------------------------------------------------------
      Construct a Node object with default values.
 
      Precondition:  None
-     Postcondition: data is empty string, next is NULL_INDEX.
+     Postcondition: data is default-initialized, next is NULL_INDEX.
     -----------------------------------------------------------------------*/
 
-    Node(const ElementType& value, int nextIndex = NULL_INDEX);
+    BasicNode(const T& value, IndexT nextIndex = IndexT(NULL_INDEX));
     /*----------------------------------------------------------------------
      Construct a Node object with given data and next index.
 
@@ -53,21 +253,232 @@ public:
     -----------------------------------------------------------------------*/
 
     /***** Data Members *****/
-    ElementType data;// Data stored in the node
-    int next;// Index of the next node
+    T data;// Data stored in the node
+    IndexT next;// Index of the next node
+};
+
+/*** Layout tags for BasicNodePool ***/
+struct InterleavedLayout {};// Array of {data, next} nodes
+struct SplitLayout {};// Links and data in separate arrays
+struct DoublyLinkedLayout {};// SplitLayout plus an array of prev links
+
+/*** BasicNodeRef: references to the fields of one pool node ***/
+template <typename T, typename IndexT>
+struct BasicNodeRef
+{
+    T& data;// Data stored in the node
+    IndexT& next;// Index of the next node
+};
+
+/*** BasicNodeHandle: a node index stamped with the node's generation ***/
+template <typename IndexT>
+struct BasicNodeHandle
+{
+    IndexT index;// Node the handle names, NULL_INDEX for none
+    unsigned int generation;// Generation of the node when the handle was made
+
+    BasicNodeHandle() : index(IndexT(NULL_INDEX)), generation(0) {}
+    BasicNodeHandle(IndexT at, unsigned int stamp) : index(at), generation(stamp) {}
+    bool isNull() const { return index == IndexT(NULL_INDEX); }
+};
+
+/*** PoolSegment: storage of one segment, specialized per layout ***/
+template <typename T, typename IndexT, typename Layout>
+class PoolSegment;
+
+template <typename T, typename IndexT>
+class PoolSegment<T, IndexT, InterleavedLayout>
+{
+public:
+    enum { IMAGE_LAYOUT = 0 };// Layout id in pool images
+    static const bool BACK_LINKS = false;// Nodes have no prev link
+    static const bool DENSE_PAYLOAD = false;// Data is strided by next links
+
+    void allocate(size_t size)
+    {
+        nodes = new BasicNode<T, IndexT>[size];
+        owned = true;
+    }
+    void release()
+    {
+        if (owned)
+            delete[] nodes;
+    }
+    T& data(size_t offset) const { return nodes[offset].data; }
+    IndexT& next(size_t offset) const { return nodes[offset].next; }
+
+    // Image support: the whole node array lives in the mapped region
+    static const bool IMAGE_CAPABLE = is_trivially_copyable<BasicNode<T, IndexT> >::value &&
+                                      !PayloadArena<T>::OWNED;
+    static const bool PAYLOAD_MAPPED = true;
+    static size_t imageBytes(size_t size) { return size * sizeof(BasicNode<T, IndexT>); }
+    void attach(char* region, size_t)
+    {
+        nodes = reinterpret_cast<BasicNode<T, IndexT>*>(region);
+        owned = false;
+    }
+
+private:
+    BasicNode<T, IndexT>* nodes;// Interleaved nodes
+    bool owned;// Allocated by allocate(), not mapped
+};
+
+template <typename T, typename IndexT>
+class PoolSegment<T, IndexT, SplitLayout>
+{
+public:
+    enum { IMAGE_LAYOUT = 1 };// Layout id in pool images
+    static const bool BACK_LINKS = false;// Nodes have no prev link
+    static const bool DENSE_PAYLOAD = true;// payloadArray() is contiguous
+
+    void allocate(size_t size)
+    {
+        payload = new T[size];
+        links = new IndexT[size];
+        ownsLinks = true;
+        ownsPayload = true;
+    }
+    void release()
+    {
+        if (ownsPayload)
+            delete[] payload;
+        if (ownsLinks)
+            delete[] links;
+    }
+    T& data(size_t offset) const { return payload[offset]; }
+    IndexT& next(size_t offset) const { return links[offset]; }
+    const T* payloadArray() const { return payload; }
+
+    // Image support: links are always mapped, payloads only when they
+    // are trivially copyable (after the links, suitably aligned). Views
+    // into a pool's arena are not: the arena is not saved with the image
+    static const bool PAYLOAD_MAPPED = is_trivially_copyable<T>::value && !PayloadArena<T>::OWNED;
+    static const bool IMAGE_CAPABLE = PAYLOAD_MAPPED || PayloadCodec<T>::AVAILABLE;
+    static size_t payloadOffset(size_t size)
+    {
+        return (size * sizeof(IndexT) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+    static size_t imageBytes(size_t size)
+    {
+        return PAYLOAD_MAPPED ? payloadOffset(size) + size * sizeof(T) : size * sizeof(IndexT);
+    }
+    void attach(char* region, size_t size)
+    {
+        links = reinterpret_cast<IndexT*>(region);
+        ownsLinks = false;
+        ownsPayload = !PAYLOAD_MAPPED;
+        payload = ownsPayload ? new T[size] : reinterpret_cast<T*>(region + payloadOffset(size));
+    }
+
+private:
+    T* payload;// Data of each node
+    IndexT* links;// Next link of each node, densely packed
+    bool ownsLinks;// links came from allocate(), not a mapping
+    bool ownsPayload;// payload came from new[]
+};
+
+template <typename T, typename IndexT>
+class PoolSegment<T, IndexT, DoublyLinkedLayout>
+{
+public:
+    enum { IMAGE_LAYOUT = 2 };// Layout id in pool images
+    static const bool BACK_LINKS = true;// prev() is available
+    static const bool DENSE_PAYLOAD = true;// payloadArray() is contiguous
+
+    void allocate(size_t size)
+    {
+        payload = new T[size];
+        links = new IndexT[2 * size];
+        nodes = size;
+        ownsLinks = true;
+        ownsPayload = true;
+    }
+    void release()
+    {
+        if (ownsPayload)
+            delete[] payload;
+        if (ownsLinks)
+            delete[] links;
+    }
+    T& data(size_t offset) const { return payload[offset]; }
+    IndexT& next(size_t offset) const { return links[offset]; }
+    const T* payloadArray() const { return payload; }
+    IndexT& prev(size_t offset) const { return links[nodes + offset]; }
+
+    // Image support: as SplitLayout, with the prev links after the next
+    // links in the same mapped array
+    static const bool PAYLOAD_MAPPED = is_trivially_copyable<T>::value && !PayloadArena<T>::OWNED;
+    static const bool IMAGE_CAPABLE = PAYLOAD_MAPPED || PayloadCodec<T>::AVAILABLE;
+    static size_t payloadOffset(size_t size)
+    {
+        return (2 * size * sizeof(IndexT) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+    static size_t imageBytes(size_t size)
+    {
+        return PAYLOAD_MAPPED ? payloadOffset(size) + size * sizeof(T) : 2 * size * sizeof(IndexT);
+    }
+    void attach(char* region, size_t size)
+    {
+        links = reinterpret_cast<IndexT*>(region);
+        nodes = size;
+        ownsLinks = false;
+        ownsPayload = !PAYLOAD_MAPPED;
+        payload = ownsPayload ? new T[size] : reinterpret_cast<T*>(region + payloadOffset(size));
+    }
+
+private:
+    T* payload;// Data of each node
+    IndexT* links;// Next links of all nodes, then their prev links
+    size_t nodes;// Number of nodes in the segment
+    bool ownsLinks;// links came from allocate(), not a mapping
+    bool ownsPayload;// payload came from new[]
 };
 
-/*** NodePool class ***/
-class NodePool
+/*** BasicNodePool class template ***/
+template <typename T, typename IndexT = int, typename Layout = InterleavedLayout>
+class BasicNodePool
 {
 public:
+    typedef BasicNodeRef<T, IndexT> NodeRef;
+    typedef BasicNodeRef<const T, const IndexT> ConstNodeRef;
+    typedef BasicNodeHandle<IndexT> Handle;
+
     /***** Function Members *****/
-    NodePool();
+    explicit BasicNodePool(size_t initialCapacity = DEFAULT_CAPACITY,
+                           size_t maxCapacity = 0,
+                           PoolConcurrency mode = POOL_SINGLE_THREADED);
     /*----------------------------------------------------------------------
      Construct a NodePool object and initialize the free list.
 
-     Precondition:  None
-     Postcondition: All nodes are linked into a free list.
+     Precondition:  initialCapacity > 0. maxCapacity is the limit the pool
+                    may grow to; 0 means "as many nodes as IndexT can name".
+                    POOL_CONCURRENT needs an IndexT of at most 32 bits.
+     Postcondition: A first segment of at least initialCapacity nodes
+                    (rounded up to a power of two) is allocated and all of
+                    its nodes are linked into the free list.
+    -----------------------------------------------------------------------*/
+
+    explicit BasicNodePool(const string& imagePath,
+                           size_t initialCapacity = DEFAULT_CAPACITY,
+                           size_t maxCapacity = 0);
+    /*----------------------------------------------------------------------
+     Construct a persistent pool backed by the image file imagePath.
+
+     Precondition:  T is trivially copyable or (SplitLayout only) has a
+                    PayloadCodec.
+     Postcondition: An existing image is reopened with its own geometry,
+                    nodes, free list and roots (the capacity arguments are
+                    ignored); otherwise a new image is created as the
+                    plain constructor would size it. If the file cannot be
+                    used an error is printed and the pool is in-memory.
+    -----------------------------------------------------------------------*/
+
+    ~BasicNodePool();
+    /*----------------------------------------------------------------------
+     Destroy the pool and free every segment (syncing a persistent pool).
+
+     Precondition:  No list is still using the pool.
+     Postcondition: All segment storage is released.
     -----------------------------------------------------------------------*/
 
     void initializePool();
@@ -75,25 +486,27 @@ public:
      Initialize the node pool by linking all nodes into a free list.
 
      Precondition:  None
-     Postcondition: Nodes are linked from 0 to NUM_NODES - 1; freePtr = 0.
+     Postcondition: Nodes are linked from 0 to capacity() - 1; freePtr = 0.
     -----------------------------------------------------------------------*/
 
     bool isFull() const;
     /*----------------------------------------------------------------------
-      Check if the node pool is full (no free nodes available).
+      Check if the node pool is full (no free nodes available and the
+      pool has reached its maximum capacity).
 
       Precondition:  None
       Postcondition: Returns true if no nodes are available, false otherwise.
     -----------------------------------------------------------------------*/
 
-    int acquireNode();
+    IndexT acquireNode();
     /*----------------------------------------------------------------------
-     Allocate a node from the free list.
-     Precondition:  At least one node is available
-     Postcondition: Returns index of allocated node.
+     Allocate a node from the free list, growing the pool if it is empty.
+     Precondition:  None
+     Postcondition: Returns index of allocated node, or NULL_INDEX if the
+                    pool is full and cannot grow.
     -----------------------------------------------------------------------*/
 
-    void releaseNode(int index);
+    void releaseNode(IndexT index);
     /*----------------------------------------------------------------------
      Return a node to the free list.
 
@@ -101,12 +514,183 @@ public:
      Postcondition: Node is inserted at the front of the free list.
     -----------------------------------------------------------------------*/
 
-    Node& getNode(int index);
+    IndexT acquireNodes(size_t count, IndexT& last);
+    /*----------------------------------------------------------------------
+     Allocate count nodes already linked through next, growing the pool
+     as needed.
+
+     Precondition:  count > 0
+     Postcondition: Returns the first node and sets last; next(last) is
+                    NULL_INDEX. Returns NULL_INDEX and takes nothing if the
+                    pool cannot supply count nodes.
+    -----------------------------------------------------------------------*/
+
+    void releaseChain(IndexT first, IndexT last, size_t count);
+    /*----------------------------------------------------------------------
+     Return a whole chain of nodes to the free list.
+
+     Precondition:  first..last is a chain of count nodes linked through
+                    next, none of them already free.
+     Postcondition: The chain is spliced onto the free list in O(1); a
+                    concurrent pool copies its links to the free-link
+                    array first, then pushes it with one compare-and-swap.
+    -----------------------------------------------------------------------*/
+
+    bool compact(IndexT& head, IndexT& tail, size_t count);
+    /*----------------------------------------------------------------------
+     Move a chain onto the lowest indices it can use (its own and free
+     ones) so that following next visits ascending indices, then relink
+     the free list in ascending order. Payloads are swapped, not copied,
+     and with DoublyLinkedLayout the prev links are rebuilt too.
+     Takes O(capacity()) time and memory.
+
+     Precondition:  Single-threaded pool; head..tail is a chain of count
+                    nodes; nothing else refers to its nodes by index.
+     Postcondition: head and tail name the moved chain. Returns false
+                    (nothing moved) for a concurrent pool or a chain that
+                    is not count nodes long.
+    -----------------------------------------------------------------------*/
+
+    bool sortFreeList();
+    /*----------------------------------------------------------------------
+     Relink the free list in ascending index order, so the next nodes
+     handed out lie next to each other.
+
+     Precondition:  Single-threaded pool.
+     Postcondition: Returns false for a concurrent pool.
+    -----------------------------------------------------------------------*/
+
+    NodeRef getNode(IndexT index);
+    ConstNodeRef getNode(IndexT index) const;
     /*----------------------------------------------------------------------
      Access a node by index.
 
      Precondition:  index is a valid node index.
-     Postcondition: Returns a reference to the node at given index.
+     Postcondition: Returns references to the data and next of the node at
+                    given index (node 0 and an error for a bad index).
+    -----------------------------------------------------------------------*/
+
+    IndexT& next(IndexT index);
+    const IndexT& next(IndexT index) const;
+    /*----------------------------------------------------------------------
+     Access the link of a node without touching its data.
+
+     Precondition:  0 <= index < capacity() (not checked).
+     Postcondition: Returns a reference to the node's next index.
+    -----------------------------------------------------------------------*/
+
+    IndexT loadNext(IndexT index) const;
+    void publishNext(IndexT index, IndexT link);
+    /*----------------------------------------------------------------------
+     Read a link with acquire and write one with release ordering, for a
+     list that one thread changes while others walk it. A node filled in
+     before its link is published is seen filled in by a reader that
+     loads the link. The links stay plain IndexT: these access one as an
+     atomic<IndexT>, which has the same size and is lock-free.
+
+     Precondition:  0 <= index < capacity() (not checked).
+     Postcondition: Same as next(index), read or written atomically.
+    -----------------------------------------------------------------------*/
+
+    IndexT& prev(IndexT index);
+    const IndexT& prev(IndexT index) const;
+    /*----------------------------------------------------------------------
+     Access the back link of a node (DoublyLinkedLayout only). The pool
+     never reads it: acquired nodes hold whatever was left there, and
+     free nodes are linked through next alone.
+
+     Precondition:  0 <= index < capacity() (not checked).
+     Postcondition: Returns a reference to the node's prev index.
+    -----------------------------------------------------------------------*/
+
+    T& data(IndexT index);
+    const T& data(IndexT index) const;
+    /*----------------------------------------------------------------------
+     Access the data of a node.
+
+     Precondition:  0 <= index < capacity() (not checked).
+     Postcondition: Returns a reference to the node's data.
+    -----------------------------------------------------------------------*/
+
+    template <typename... Args>
+    void emplace(IndexT index, Args&&... args);
+    /*----------------------------------------------------------------------
+     Replace the data of a node with a T constructed in place from args,
+     instead of assigning a temporary.
+
+     Precondition:  0 <= index < capacity() (not checked).
+     Postcondition: data(index) is T(args...). If that constructor throws,
+                    the node holds T() and the exception propagates.
+    -----------------------------------------------------------------------*/
+
+    IndexT findPayload(const T& value, IndexT from = 0) const;
+    /*----------------------------------------------------------------------
+     Find the lowest node index at or after from whose data equals value,
+     scanning the payload arrays in index order (see PayloadScan.h) rather
+     than following links. Every node is looked at, including free nodes
+     and nodes of other lists.
+
+     Precondition:  The pool is quiescent.
+     Postcondition: Returns the node index, or NULL_INDEX if none matches.
+    -----------------------------------------------------------------------*/
+
+    long findInChain(IndexT head, const T& value) const;
+    /*----------------------------------------------------------------------
+     Find the position of the first node equal to value in the chain that
+     starts at head. The payload arrays are scanned first; without a
+     match the chain is not touched at all. Otherwise the matching nodes
+     are marked and the chain is walked through next links alone until
+     the first marked node. Nodes of other chains still match, so the
+     scan pays off when the chain holds most of the nodes in use. For a
+     PayloadScan type the first call also fills every free node with a
+     value whose bits are all set, and from then on nodes are filled as
+     they are released, so removed values are not found by the scan; a
+     search for that value itself compares along the chain instead.
+
+     Precondition:  The pool is quiescent, and no other findInChain runs;
+                    head starts a chain of the pool or is NULL_INDEX.
+     Postcondition: Returns the position, or -1 if no node matches.
+    -----------------------------------------------------------------------*/
+
+    void addReference(IndexT index);
+    bool dropReference(IndexT index);
+    bool isShared(IndexT index) const;
+    /*----------------------------------------------------------------------
+     Reference counts for lists that share nodes copy-on-write. A node
+     starts with one reference (the list or node that links to it);
+     addReference records another. dropReference removes one and returns
+     true if the node is still referenced, or returns false (count left
+     alone) if the caller held the only reference and may release it.
+     isShared is true while a node has more than one reference. The
+     counts live beside the segments and are only allocated once a node
+     is shared; they are not saved in a persistent image.
+
+     Precondition:  0 <= index < capacity(); single-threaded use.
+     Postcondition: See above.
+    -----------------------------------------------------------------------*/
+
+    Handle handleOf(IndexT index);
+    bool isValid(Handle handle) const;
+    void retire(IndexT index);
+    /*----------------------------------------------------------------------
+     Generational handles. Each node has a generation that changes when
+     the node is released (releaseNode, releaseChain, clear), when its
+     payload is moved to another node (compact), or on retire(). A handle
+     made by handleOf records the index and the current generation, and
+     isValid is true until the generation changes, so a stale handle is
+     detected instead of naming whatever the node holds next. With NDEBUG
+     isValid is the single compare of the two generations; otherwise it
+     also rejects null handles and handles the pool never made.
+
+     The generations are allocated by the first handleOf and kept beside
+     the segments like the reference counts; until then releases do not
+     pay for them, after it releaseChain walks the chain it releases.
+     They are not saved in a persistent image, and a generation wraps
+     after 2^32 releases of one node.
+
+     Precondition:  handleOf and retire: 0 <= index < capacity().
+                    Single-threaded use.
+     Postcondition: See above.
     -----------------------------------------------------------------------*/
 
     void displayFreeList() const;
@@ -122,7 +706,22 @@ public:
      Reset the node pool to its initial state.
 
      Precondition:  None
-     Postcondition: All nodes are returned to the free list.
+     Postcondition: All nodes are returned to the free list. Segments that
+                    were added by growth are kept. A pool of ArenaString
+                    resets its arena in O(1) instead of clearing every
+                    node's data.
+    -----------------------------------------------------------------------*/
+
+    typedef typename PayloadArena<T>::Arena Arena;
+    Arena& arena();
+    const Arena& arena() const;
+    /*----------------------------------------------------------------------
+     Access the arena that holds the bytes of the pool's payloads. For
+     ArenaString this is a StringArena shared by every list on the pool;
+     other payloads own their bytes and the arena is empty.
+
+     Precondition:  None
+     Postcondition: Views in the arena stay valid until clear().
     -----------------------------------------------------------------------*/
 
     void list() const;
@@ -133,7 +732,7 @@ public:
      Postcondition: Outputs each node's index, data, and next value
     -----------------------------------------------------------------------*/
 
-    int length() const;
+    size_t length() const;
     /*----------------------------------------------------------------------
      Return the number of nodes currently in use.
 
@@ -141,10 +740,289 @@ public:
      Postcondition: Returns the count of nodes not in the free list.
     -----------------------------------------------------------------------*/
 
+    size_t capacity() const;
+    /*----------------------------------------------------------------------
+     Return the number of nodes currently allocated in all segments.
+
+     Precondition:  None
+     Postcondition: Returns the number of valid node indices.
+    -----------------------------------------------------------------------*/
+
+    bool grow();
+    /*----------------------------------------------------------------------
+     Add one segment to the pool and link its nodes into the free list.
+
+     Precondition:  None
+     Postcondition: Returns true and doubles capacity() (the first
+                    growth adds a segment as large as segment 0) unless
+                    the maximum capacity has been reached.
+    -----------------------------------------------------------------------*/
+
+    bool isConcurrent() const;
+    /*----------------------------------------------------------------------
+     Check whether the pool was built with POOL_CONCURRENT.
+
+     Precondition:  None
+     Postcondition: Returns true if the free list is the lock-free stack.
+    -----------------------------------------------------------------------*/
+
+    void setMagazineSize(size_t size);
+    size_t magazineSize() const;
+    /*----------------------------------------------------------------------
+     Set or read how many free indices each thread may cache (0 disables
+     magazines). Magazines are only used by a concurrent pool.
+
+     Precondition:  The pool is quiescent.
+     Postcondition: Every magazine is flushed and holds at most size nodes.
+    -----------------------------------------------------------------------*/
+
+    void flushMagazine();
+    /*----------------------------------------------------------------------
+     Return the nodes cached by the calling thread to the shared free list.
+
+     Precondition:  None
+     Postcondition: The calling thread's magazine for this pool is empty.
+    -----------------------------------------------------------------------*/
+
+    PoolStats stats() const;
+    /*----------------------------------------------------------------------
+     Take a snapshot of the pool's counters; safe from any thread.
+
+     Precondition:  None
+     Postcondition: inUse and capacity are always filled in; the other
+                    fields are 0 unless built with NODEPOOL_STATS.
+    -----------------------------------------------------------------------*/
+
+    void resetStats();
+    /*----------------------------------------------------------------------
+     Restart the counters collected under NODEPOOL_STATS.
+
+     Precondition:  None
+     Postcondition: Totals and failures are 0; the high-water mark is the
+                    current number of nodes off the free list.
+    -----------------------------------------------------------------------*/
+
+    bool isPersistent() const;
+    /*----------------------------------------------------------------------
+     Check whether the pool is backed by an image file.
+
+     Precondition:  None
+     Postcondition: Returns true if the persistent constructor succeeded.
+    -----------------------------------------------------------------------*/
+
+    bool sync();
+    /*----------------------------------------------------------------------
+     Write a consistent checkpoint of a persistent pool to its image.
+
+     Precondition:  The pool is persistent.
+     Postcondition: Returns true once nodes, payloads, free list and roots
+                    are on disk; false (with an error) otherwise.
+    -----------------------------------------------------------------------*/
+
+    bool setRoot(int slot, IndexT head, IndexT tail, size_t count);
+    bool getRoot(int slot, IndexT& head, IndexT& tail, size_t& count) const;
+    /*----------------------------------------------------------------------
+     Record or look up the chain a list keeps in root slot [0, POOL_ROOTS).
+     Roots are saved with the image by sync().
+
+     Precondition:  0 <= slot < POOL_ROOTS
+     Postcondition: Return false (with an error) for a bad slot.
+    -----------------------------------------------------------------------*/
+
 private:
+    BasicNodePool(const BasicNodePool&);            // Not copyable
+    BasicNodePool& operator=(const BasicNodePool&); // Not assignable
+
+    size_t segmentSize(int segment) const;
+    /*----------------------------------------------------------------------
+     Return the number of nodes held by a segment.
+
+     Precondition:  0 <= segment < MAX_SEGMENTS
+     Postcondition: Returns base for segment 0, base * 2^(segment-1) after.
+    -----------------------------------------------------------------------*/
+
+    void locate(size_t index, int& segment, size_t& offset) const;
+    /*----------------------------------------------------------------------
+     Split a node index into its segment and offset within that segment.
+
+     Precondition:  index < capacity()
+     Postcondition: segment and offset address the node.
+    -----------------------------------------------------------------------*/
+
+    void configure(size_t initialCapacity, size_t maxCapacity);
+    /*----------------------------------------------------------------------
+     Derive maxNodes and baseShift from the constructor arguments.
+    -----------------------------------------------------------------------*/
+
+    bool allocateSegment(int segment);
+    /*----------------------------------------------------------------------
+     Provide storage for a segment: from the heap, or mapped from the
+     image for a persistent pool (extending the file as needed).
+
+     Precondition:  segment == segmentCount
+     Postcondition: Returns false only if the image cannot be extended.
+    -----------------------------------------------------------------------*/
+
+    bool openImage(const string& imagePath);
+    bool checkFreeList() const;
+    bool loadPayloads();
+    void abandonImage(int mapped);
+    size_t regionOffset(int segment) const;
+    /*----------------------------------------------------------------------
+     Image helpers: open or create the image file, check the stored free
+     list, decode the payload arena, drop an image that failed to load
+     (unmapping its first mapped segments), and find where a segment's
+     region starts in the file.
+    -----------------------------------------------------------------------*/
+
+    bool addSegment();
+    /*----------------------------------------------------------------------
+     Allocate the next segment and push its nodes onto the free list.
+
+     Precondition:  Caller holds growLock in concurrent mode.
+     Postcondition: Returns false if the maximum capacity was reached.
+    -----------------------------------------------------------------------*/
+
+    void relinkFree(const vector<char>& isFree);
+    /*----------------------------------------------------------------------
+     Rebuild the single-threaded free list from a mark per node.
+
+     Precondition:  isFree has capacity() entries, marking every free node.
+     Postcondition: The marked nodes form the free list, in ascending order.
+    -----------------------------------------------------------------------*/
+
+    static bool isScanFiller(const T& value);
+    void stampFree(IndexT index) const;
+    /*----------------------------------------------------------------------
+     The scan filler is a T with every bit set. Once findInChain has run,
+     stampFree() gives a node being freed that payload, so payload scans
+     skip free nodes; isScanFiller() recognizes it.
+
+     Precondition:  T is a PayloadScan type (stampFree does nothing else).
+    -----------------------------------------------------------------------*/
+
+    atomic<IndexT>& freeLink(IndexT index) const;
+    IndexT firstFree() const;
+    IndexT nextFree(IndexT index) const;
+    /*----------------------------------------------------------------------
+     Walk the free list in either mode: firstFree() is its head and
+     nextFree() follows next (single-threaded) or the free-link array
+     (concurrent).
+    -----------------------------------------------------------------------*/
+
+    IndexT popFree();
+    void pushFree(IndexT first, IndexT last);
+    /*----------------------------------------------------------------------
+     Lock-free pop of one node and push of a chain first..last (already
+     linked through freeLink) on the concurrent free list.
+
+     Precondition:  Concurrent mode.
+     Postcondition: popFree() returns NULL_INDEX if the stack is empty.
+    -----------------------------------------------------------------------*/
+
+    /*** Magazine: one thread's cache of free indices of one pool ***/
+    struct Magazine
+    {
+        atomic<BasicNodePool*> owner;// Pool of the cached nodes, 0 once it is gone
+        vector<IndexT> slots;// Cached free indices, slots[0..count-1]
+        atomic<size_t> count;// Number of cached indices
+    };
+
+    /*** MagazineRack: the magazines of one thread ***/
+    struct MagazineRack
+    {
+        vector<Magazine*> magazines;
+        ~MagazineRack();// Thread exit: flush every magazine to its pool
+    };
+
+    Magazine* localMagazine();
+    /*----------------------------------------------------------------------
+     Find or create the calling thread's magazine for this pool.
+
+     Precondition:  Concurrent mode with magazines enabled.
+     Postcondition: Returns a magazine registered with this pool.
+    -----------------------------------------------------------------------*/
+
+    size_t refillMagazine(Magazine* magazine);
+    void spillMagazine(Magazine* magazine, size_t count);
+    /*----------------------------------------------------------------------
+     Move a batch between a magazine and the shared stack: refill pops up
+     to half a magazine (growing the pool if needed) and returns how many
+     nodes it got; spill pushes the top count cached nodes as one chain.
+    -----------------------------------------------------------------------*/
+
+    size_t popChain(IndexT* out, size_t count);
+    /*----------------------------------------------------------------------
+     Lock-free pop of up to count nodes from the concurrent free list.
+
+     Precondition:  Concurrent mode, out has room for count indices.
+     Postcondition: Returns the number of indices stored in out.
+    -----------------------------------------------------------------------*/
+
+    void countOut(size_t count);
+    void countIn(size_t count);
+    /*----------------------------------------------------------------------
+     Track nodes leaving and rejoining the (shared) free list; nodes in a
+     magazine count as out.
+    -----------------------------------------------------------------------*/
+
+    static mutex& registryLock();
+    /*----------------------------------------------------------------------
+     Lock guarding every pool's magazine list and the owner of each
+     magazine, so a pool and an exiting thread never free the same one.
+    -----------------------------------------------------------------------*/
+
+    static unsigned long long packHead(unsigned int tag, IndexT index);
+    static IndexT headIndex(unsigned long long head);
+    /*----------------------------------------------------------------------
+     Build and split the tagged head word: tag in the high 32 bits, the
+     node index in the low 32 bits.
+    -----------------------------------------------------------------------*/
+
+    typedef PoolSegment<T, IndexT, Layout> Segment;
+
     /***** Data Members *****/
-    Node pool[NUM_NODES];// Array of nodes
-    int freePtr;// Index of first free node
+    enum { MAX_SEGMENTS = 64 };
+    PoolSegment<T, IndexT, Layout> segments[MAX_SEGMENTS];// Segment storage, never moved
+    int segmentCount;// Number of allocated segments
+    int baseShift;// log2 of the size of segment 0
+    atomic<size_t> myCapacity;// Total nodes in all segments
+    size_t maxNodes;// Capacity the pool may grow to
+    IndexT freePtr;// Index of first free node (single-threaded)
+
+    bool concurrent;// Built with POOL_CONCURRENT
+    atomic<unsigned long long> freeHead;// Tagged head of the free stack
+    atomic<IndexT>* freeLinks[MAX_SEGMENTS];// Free stack links per segment
+    mutex growLock;// Serializes growth in concurrent mode
+
+    size_t magazineCapacity;// Indices a magazine may hold, 0 = no magazines
+    vector<Magazine*> magazines;// Magazines of all threads (registryLock)
+    static thread_local MagazineRack rack;// Magazines of the calling thread
+
+    int imageFd;// Image file descriptor, -1 if not persistent
+    void* imageRegions[MAX_SEGMENTS];// Mapped region of each segment
+    PoolImageHeader image;// Header of the image (roots in every mode)
+
+    vector<unsigned int> references;// Extra references per node, empty until shared
+    vector<unsigned int> generations;// Generation per node, empty until a handle is made
+    mutable bool freeStamped;// Free nodes hold the scan filler, set by findInChain
+    mutable vector<unsigned long long> chainMarks;// findInChain's match bits, kept zeroed
+    mutable vector<IndexT> chainHits;// Nodes marked in chainMarks by one search
+    Arena payloadArena;// Bytes of the payloads (see PayloadArena)
+    StatCounter offList;// Nodes not on the (shared) free list
+#ifdef NODEPOOL_STATS
+    StatCounter highWater;// Largest offList seen
+    StatCounter acquires;// Nodes handed to callers
+    StatCounter releases;// Nodes returned by callers
+    StatCounter failures;// Acquire calls that failed
+#endif
 };
 
-#endif
\ No newline at end of file
+typedef BasicNode<ElementType, int> Node;
+typedef BasicNodeHandle<int> NodeHandle;
+typedef BasicNodePool<ElementType, int, SplitLayout> NodePool;
+typedef BasicNodePool<ElementType, int, DoublyLinkedLayout> DoublyNodePool;
+
+#include "nodepool.tpp"
+
+#endif
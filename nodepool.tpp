@@ -0,0 +1,1963 @@
+/*
+ * Name: Mhamad El Ayoubi, Ali Zreikat, Nehme Nehme
+ * Date Started: November 15, 2025
+ * Date Ended:  November **, 2025
+ * Assignment: NodePool Implementation
+ *
+ * Description:
+ * This file implements a node pool for managing nodes stored in segments.
+ * Nodes are acquired and released through a free list mechanism.
+ * When the free list is empty a new segment is added, so the pool grows
+ * without moving existing nodes. Included at the end of nodepool.h
+ * because BasicNodePool is a class template.
+ */
+
+#include <iostream>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+const unsigned long long HEAD_INDEX_MASK = 0xFFFFFFFFull; // Low half of a tagged head
+
+/* -----------------------------
+   floorLog2()
+   Purpose: Position of the highest set bit of a non-zero value.
+   Input: value (size_t)
+   Output: floor(log2(value))
+   ----------------------------- */
+inline int floorLog2(size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return int(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll(value);
+#else
+    int result = 0;
+    while (value >>= 1) {
+        result++;
+    }
+    return result;
+#endif
+}
+
+/* -----------------------------
+   writeFully()
+   Purpose: pwrite() a whole buffer, retrying short writes.
+   Input: fd (int), data, length (size_t), offset (off_t)
+   Output: true if every byte was written
+   ----------------------------- */
+inline bool writeFully(int fd, const char* data, size_t length, off_t offset)
+{
+    while (length > 0) {
+        ssize_t written = pwrite(fd, data, length, offset);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= size_t(written);
+        offset += written;
+    }
+    return true;
+}
+
+/* -----------------------------
+   Node Default Constructor
+   Purpose: Initialize a node with default values.
+   Input: None
+   Output: Node with default data and null link
+   ----------------------------- */
+template <typename T, typename IndexT>
+BasicNode<T, IndexT>::BasicNode()
+{
+    data = T();                 // Default-initialize the data
+    next = IndexT(NULL_INDEX);  // Mark as not linked
+}
+
+/* -----------------------------
+   Node Parameterized Constructor
+   Purpose: Initialize a node with given data and next index.
+   Input: value (T), nextIndex (IndexT)
+   Output: Node with specified data and link
+   ----------------------------- */
+template <typename T, typename IndexT>
+BasicNode<T, IndexT>::BasicNode(const T& value, IndexT nextIndex)
+{
+    data = value;
+    next = nextIndex;
+}
+
+/* -----------------------------
+   NodePool Constructor
+   Purpose: Allocate the first segment and set up free list.
+   Input: initialCapacity, maxCapacity (0 = limited only by IndexT)
+   Output: NodePool with all nodes linked in free list
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+BasicNodePool<T, IndexT, Layout>::BasicNodePool(size_t initialCapacity, size_t maxCapacity,
+                                                PoolConcurrency mode)
+{
+    concurrent = (mode == POOL_CONCURRENT);
+    if (concurrent && sizeof(IndexT) > 4) {
+        cerr << "Error: Concurrent pools need a 32-bit index type." << endl;
+        concurrent = false;
+    }
+    configure(initialCapacity, maxCapacity);
+
+    allocateSegment(0);
+    freeLinks[0] = concurrent ? new atomic<IndexT>[segmentSize(0)] : 0;
+    segmentCount = 1;
+    myCapacity.store(segmentSize(0) < maxNodes ? segmentSize(0) : maxNodes);
+
+    initializePool(); // Set up the free list
+}
+
+/* -----------------------------
+   Persistent NodePool Constructor
+   Purpose: Open or create a pool image file.
+   Input: imagePath, initialCapacity, maxCapacity (for a new image)
+   Output: NodePool mapped from the image (in-memory on failure)
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+BasicNodePool<T, IndexT, Layout>::BasicNodePool(const string& imagePath, size_t initialCapacity,
+                                                size_t maxCapacity)
+{
+    concurrent = false;
+    configure(initialCapacity, maxCapacity);
+    if (openImage(imagePath)) {
+        return;
+    }
+
+    // Image unusable: carry on as a plain pool
+    allocateSegment(0);
+    freeLinks[0] = 0;
+    segmentCount = 1;
+    myCapacity.store(segmentSize(0) < maxNodes ? segmentSize(0) : maxNodes);
+    initializePool();
+}
+
+/* -----------------------------
+   configure()
+   Purpose: Set up the members shared by both constructors.
+   Input: initialCapacity, maxCapacity (0 = limited only by IndexT)
+   Output: maxNodes, baseShift and an empty image header
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::configure(size_t initialCapacity, size_t maxCapacity)
+{
+    freeHead.store(0);
+    magazineCapacity = 0;
+    freeStamped = false;
+    imageFd = -1;
+    segmentCount = 0;
+    for (int s = 0; s < MAX_SEGMENTS; s++) {
+        imageRegions[s] = 0;
+        freeLinks[s] = 0;
+    }
+    memset(&image, 0, sizeof(image));
+    for (int r = 0; r < POOL_ROOTS; r++) {
+        image.roots[r].head = NULL_INDEX;
+        image.roots[r].tail = NULL_INDEX;
+    }
+
+    // Largest node count whose indices do not collide with NULL_INDEX
+    size_t indexLimit = size_t(numeric_limits<IndexT>::max());
+    if (numeric_limits<IndexT>::is_signed == false) {
+        indexLimit--; // IndexT(NULL_INDEX) is the maximum value
+    }
+
+    maxNodes = (maxCapacity == 0 || maxCapacity > indexLimit) ? indexLimit : maxCapacity;
+    if (initialCapacity == 0) {
+        initialCapacity = 1;
+    }
+    if (initialCapacity > maxNodes) {
+        initialCapacity = maxNodes;
+    }
+
+    // Segment 0 is the initial capacity rounded up to a power of two
+    baseShift = 0;
+    while ((size_t(1) << baseShift) < initialCapacity) {
+        baseShift++;
+    }
+}
+
+/* -----------------------------
+   allocateSegment()
+   Purpose: Give a segment heap storage or map it from the image.
+   Input: segment (int)
+   Output: true unless the image could not be extended or mapped
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::allocateSegment(int segment)
+{
+    size_t size = segmentSize(segment);
+    if (imageFd < 0) {
+        segments[segment].allocate(size);
+        return true;
+    }
+
+    if constexpr (Segment::IMAGE_CAPABLE) {
+        size_t offset = regionOffset(segment);
+        size_t bytes = Segment::imageBytes(size);
+        struct stat info;
+        if (fstat(imageFd, &info) != 0 ||
+            (size_t(info.st_size) < offset + bytes && ftruncate(imageFd, off_t(offset + bytes)) != 0)) {
+            cerr << "Error: Cannot extend pool image." << endl;
+            return false;
+        }
+
+        // Copy-on-write: the file only changes when sync() writes it
+        void* region = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, imageFd, off_t(offset));
+        if (region == MAP_FAILED) {
+            cerr << "Error: Cannot map pool image." << endl;
+            return false;
+        }
+        imageRegions[segment] = region;
+        segments[segment].attach(static_cast<char*>(region), size);
+        return true;
+    }
+    return false;
+}
+
+/* -----------------------------
+   regionOffset()
+   Purpose: File offset of a segment's region in the image.
+   Input: segment (int)
+   Output: Offset, a multiple of the image's region alignment
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::regionOffset(int segment) const
+{
+    size_t align = image.regionAlign;
+    size_t offset = align; // The header has the first page to itself
+    for (int s = 0; s < segment; s++) {
+        offset += (Segment::imageBytes(segmentSize(s)) + align - 1) / align * align;
+    }
+    return offset;
+}
+
+/* -----------------------------
+   openImage()
+   Purpose: Reopen an existing image or create a new one.
+   Input: imagePath
+   Output: true if the pool now lives in the image
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::openImage(const string& imagePath)
+{
+    if (!Segment::IMAGE_CAPABLE) {
+        cerr << "Error: Pool payloads cannot be stored in an image." << endl;
+        return false;
+    }
+
+    int fd = open(imagePath.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        cerr << "Error: Cannot open pool image " << imagePath << endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    size_t page = size_t(sysconf(_SC_PAGESIZE));
+    PoolImageHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "NODEPOOL", 8);
+    header.version = POOL_IMAGE_VERSION;
+    header.indexBytes = sizeof(IndexT);
+    header.payloadBytes = Segment::PAYLOAD_MAPPED ? sizeof(T) : 0;
+    header.layout = Segment::IMAGE_LAYOUT;
+
+    if (info.st_size == 0) {
+        // New image laid out like a fresh in-memory pool
+        header.regionAlign = (unsigned int)page;
+        memcpy(header.roots, image.roots, sizeof(header.roots));
+        image = header;
+        imageFd = fd;
+        if (!allocateSegment(0)) {
+            close(fd);
+            imageFd = -1;
+            return false;
+        }
+        segmentCount = 1;
+        myCapacity.store(segmentSize(0) < maxNodes ? segmentSize(0) : maxNodes);
+        initializePool();
+        return sync();
+    }
+
+    PoolImageHeader stored;
+    const char* problem = 0;
+    if (pread(fd, &stored, sizeof(stored), 0) != ssize_t(sizeof(stored)) ||
+        memcmp(stored.magic, header.magic, 8) != 0) {
+        problem = "not a pool image";
+    }
+    else if (stored.version != header.version) {
+        problem = "unsupported image version";
+    }
+    else if (stored.indexBytes != header.indexBytes || stored.payloadBytes != header.payloadBytes ||
+             stored.layout != header.layout) {
+        problem = "image was written by a different pool type";
+    }
+    else if (stored.clean != 1) {
+        problem = "image was not synced completely";
+    }
+    else if (stored.regionAlign == 0 || stored.regionAlign % page != 0 ||
+             stored.segmentCount < 1 || stored.segmentCount > MAX_SEGMENTS ||
+             stored.baseShift < 0 || stored.baseShift > 40 ||
+             stored.maxNodes > (unsigned long long)numeric_limits<IndexT>::max() ||
+             stored.capacity > stored.maxNodes) {
+        problem = "image header is damaged";
+    }
+    if (problem != 0) {
+        cerr << "Error: Cannot reopen pool image " << imagePath << ": " << problem << endl;
+        close(fd);
+        return false;
+    }
+
+    // Segments 0..k-1 hold 2^(baseShift+k-1) nodes; the last one may be cut
+    int lastShift = stored.baseShift + stored.segmentCount - 1;
+    size_t fileBytes = size_t(info.st_size);
+    unsigned long long below = (lastShift > 62 || stored.segmentCount == 1) ? 0 : 1ULL << (lastShift - 1);
+    if (lastShift > 62 || (1ULL << lastShift) > fileBytes || // Every node takes file space
+        stored.capacity <= below || stored.capacity > (1ULL << lastShift) ||
+        stored.used > stored.capacity ||
+        (stored.freePtr != (long long)IndexT(NULL_INDEX) &&
+         (stored.freePtr < 0 || (unsigned long long)stored.freePtr >= stored.capacity))) {
+        cerr << "Error: Cannot reopen pool image " << imagePath << ": image header is damaged" << endl;
+        close(fd);
+        return false;
+    }
+
+    // Take the geometry of the stored pool
+    image = stored;
+    baseShift = stored.baseShift;
+    maxNodes = size_t(stored.maxNodes);
+    size_t arenaOffset = regionOffset(stored.segmentCount);
+    if (fileBytes < arenaOffset || stored.arenaOffset != arenaOffset ||
+        stored.arenaBytes > fileBytes - arenaOffset) {
+        cerr << "Error: Cannot reopen pool image " << imagePath << ": file is truncated" << endl;
+        imageFd = fd;
+        abandonImage(0);
+        return false;
+    }
+
+    imageFd = fd;
+    for (int s = 0; s < stored.segmentCount; s++) {
+        if (!allocateSegment(s)) {
+            abandonImage(s); // Undo the segments mapped so far
+            return false;
+        }
+    }
+    segmentCount = stored.segmentCount;
+    myCapacity.store(size_t(stored.capacity));
+    freePtr = IndexT(stored.freePtr);
+    offList.set(stored.used);
+
+    if (!checkFreeList()) {
+        cerr << "Error: Cannot reopen pool image " << imagePath << ": free list is damaged" << endl;
+        abandonImage(segmentCount);
+        return false;
+    }
+    if (!loadPayloads()) {
+        cerr << "Error: Cannot reopen pool image " << imagePath << ": payload arena is damaged" << endl;
+        abandonImage(segmentCount);
+        return false;
+    }
+    return true;
+}
+
+/* -----------------------------
+   checkFreeList()
+   Purpose: Check the free list read from an image.
+   Input: None
+   Output: true if it holds exactly the capacity() - used nodes, each
+           in range, without a cycle
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::checkFreeList() const
+{
+    size_t expected = capacity() - size_t(image.used);
+    size_t found = 0;
+    for (IndexT i = freePtr; i != IndexT(NULL_INDEX); i = next(i)) {
+        if (size_t(i) >= capacity() || found == expected) {
+            return false; // Out of range, too long or a cycle
+        }
+        found++;
+    }
+    return found == expected;
+}
+
+/* -----------------------------
+   abandonImage()
+   Purpose: Drop an image that failed to load.
+   Input: mapped (segments mapped so far)
+   Output: Segments unmapped, file closed, image header reset
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::abandonImage(int mapped)
+{
+    for (int u = 0; u < mapped; u++) {
+        segments[u].release();
+        munmap(imageRegions[u], Segment::imageBytes(segmentSize(u)));
+        imageRegions[u] = 0;
+    }
+    close(imageFd);
+    imageFd = -1;
+    segmentCount = 0;
+    myCapacity.store(0);
+    offList.set(0);
+
+    // Roots from the file name nodes the fallback pool does not have
+    memset(&image, 0, sizeof(image));
+    for (int r = 0; r < POOL_ROOTS; r++) {
+        image.roots[r].head = NULL_INDEX;
+        image.roots[r].tail = NULL_INDEX;
+    }
+}
+
+/* -----------------------------
+   loadPayloads()
+   Purpose: Decode the payload arena into the nodes in use.
+   Input: None
+   Output: false if the arena is damaged
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::loadPayloads()
+{
+    if constexpr (!Segment::PAYLOAD_MAPPED) {
+        if (image.arenaBytes == 0) {
+            return true;
+        }
+
+        // Free nodes have no record in the arena; checkFreeList() ran first
+        vector<bool> isFree(capacity(), false);
+        for (IndexT i = freePtr; i != IndexT(NULL_INDEX); i = next(i)) {
+            isFree[size_t(i)] = true;
+        }
+
+        size_t page = image.regionAlign;
+        size_t start = size_t(image.arenaOffset) / page * page;
+        size_t length = size_t(image.arenaOffset - start + image.arenaBytes);
+        void* arena = mmap(0, length, PROT_READ, MAP_PRIVATE, imageFd, off_t(start));
+        if (arena == MAP_FAILED) {
+            return false;
+        }
+        madvise(arena, length, MADV_SEQUENTIAL);
+
+        const char* in = static_cast<const char*>(arena) + (image.arenaOffset - start);
+        const char* end = in + image.arenaBytes;
+        bool intact = true;
+        for (size_t i = 0; i < capacity() && intact; i++) {
+            if (!isFree[i]) {
+                in = PayloadCodec<T>::read(in, end, data(IndexT(i)));
+                intact = (in != 0);
+            }
+        }
+        munmap(arena, length);
+        return intact && in == end; // Every byte accounted for
+    }
+    return true;
+}
+
+/* -----------------------------
+   sync()
+   Purpose: Write a consistent checkpoint of the pool to its image.
+   Input: None
+   Output: true if the image is complete on disk
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::sync()
+{
+    if (imageFd < 0) {
+        cerr << "Error: Pool is not persistent." << endl;
+        return false;
+    }
+
+    // Mark the image unclean until every part is written
+    image.clean = 0;
+    bool ok = writeFully(imageFd, reinterpret_cast<const char*>(&image), sizeof(image), 0) &&
+              fdatasync(imageFd) == 0;
+
+    for (int s = 0; ok && s < segmentCount; s++) {
+        ok = writeFully(imageFd, static_cast<const char*>(imageRegions[s]),
+                        Segment::imageBytes(segmentSize(s)), off_t(regionOffset(s)));
+    }
+
+    size_t arenaOffset = regionOffset(segmentCount);
+    size_t arenaBytes = 0;
+    if constexpr (!Segment::PAYLOAD_MAPPED) {
+        vector<bool> isFree(capacity(), false);
+        for (IndexT i = freePtr; i != IndexT(NULL_INDEX); i = next(i)) {
+            isFree[size_t(i)] = true;
+        }
+
+        // Encode payloads of nodes in use, writing in large blocks
+        vector<char> block(1 << 20);
+        size_t used = 0;
+        for (size_t i = 0; ok && i < capacity(); i++) {
+            if (isFree[i]) {
+                continue;
+            }
+            const T& value = data(IndexT(i));
+            size_t need = PayloadCodec<T>::size(value);
+            if (used + need > block.size()) {
+                ok = writeFully(imageFd, &block[0], used, off_t(arenaOffset + arenaBytes));
+                arenaBytes += used;
+                used = 0;
+                if (need > block.size()) {
+                    block.resize(need);
+                }
+            }
+            PayloadCodec<T>::write(value, &block[used]);
+            used += need;
+        }
+        if (ok && used > 0) {
+            ok = writeFully(imageFd, &block[0], used, off_t(arenaOffset + arenaBytes));
+            arenaBytes += used;
+        }
+    }
+
+    if (ok) {
+        ok = ftruncate(imageFd, off_t(arenaOffset + arenaBytes)) == 0;
+    }
+    if (ok) {
+        image.baseShift = baseShift;
+        image.segmentCount = segmentCount;
+        image.capacity = capacity();
+        image.maxNodes = maxNodes;
+        image.used = offList.get();
+        image.freePtr = (long long)freePtr;
+        image.arenaOffset = arenaOffset;
+        image.arenaBytes = arenaBytes;
+        image.clean = 1;
+        ok = fdatasync(imageFd) == 0 &&
+             writeFully(imageFd, reinterpret_cast<const char*>(&image), sizeof(image), 0) &&
+             fdatasync(imageFd) == 0;
+    }
+    if (!ok) {
+        cerr << "Error: Cannot write pool image." << endl;
+    }
+    return ok;
+}
+
+/* -----------------------------
+   isPersistent()
+   Purpose: Report whether the pool lives in an image file.
+   Input: None
+   Output: true for a pool opened by the persistent constructor
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::isPersistent() const
+{
+    return imageFd >= 0;
+}
+
+/* -----------------------------
+   setRoot() / getRoot()
+   Purpose: Record and look up the chain of a list.
+   Input: slot (int), head, tail (IndexT), count (size_t)
+   Output: false for a bad slot
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::setRoot(int slot, IndexT head, IndexT tail, size_t count)
+{
+    if (slot < 0 || slot >= POOL_ROOTS) {
+        cerr << "Error: Invalid root slot " << slot << endl;
+        return false;
+    }
+    image.roots[slot].head = (long long)head;
+    image.roots[slot].tail = (long long)tail;
+    image.roots[slot].count = count;
+    return true;
+}
+
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::getRoot(int slot, IndexT& head, IndexT& tail, size_t& count) const
+{
+    if (slot < 0 || slot >= POOL_ROOTS) {
+        cerr << "Error: Invalid root slot " << slot << endl;
+        return false;
+    }
+    head = IndexT(image.roots[slot].head);
+    tail = IndexT(image.roots[slot].tail);
+    count = size_t(image.roots[slot].count);
+    return true;
+}
+
+/* -----------------------------
+   NodePool Destructor
+   Purpose: Free every segment, checkpointing a persistent pool.
+   Input: None
+   Output: Segment storage released
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+BasicNodePool<T, IndexT, Layout>::~BasicNodePool()
+{
+    {
+        // Magazines belong to their threads; just tell them the pool is gone
+        lock_guard<mutex> guard(registryLock());
+        for (size_t m = 0; m < magazines.size(); m++) {
+            magazines[m]->owner.store(0);
+        }
+    }
+    if (imageFd >= 0) {
+        sync(); // Closing a persistent pool checkpoints it
+    }
+    for (int s = 0; s < segmentCount; s++) {
+        segments[s].release();
+        delete[] freeLinks[s];
+        if (imageRegions[s] != 0) {
+            munmap(imageRegions[s], Segment::imageBytes(segmentSize(s)));
+        }
+    }
+    if (imageFd >= 0) {
+        close(imageFd);
+    }
+}
+
+/* -----------------------------
+   segmentSize()
+   Purpose: Number of nodes stored in a segment.
+   Input: segment (int)
+   Output: base for segment 0, base * 2^(segment-1) otherwise
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::segmentSize(int segment) const
+{
+    if (segment == 0) {
+        return size_t(1) << baseShift;
+    }
+    return size_t(1) << (baseShift + segment - 1);
+}
+
+/* -----------------------------
+   locate()
+   Purpose: Map a node index to its segment and offset.
+   Input: index (size_t)
+   Output: segment and offset (by reference)
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline void BasicNodePool<T, IndexT, Layout>::locate(size_t index, int& segment, size_t& offset) const
+{
+    if ((index >> baseShift) == 0) {
+        segment = 0;
+        offset = index;
+        return;
+    }
+    int high = floorLog2(index);             // Segment k starts at 2^(baseShift+k-1)
+    segment = high - baseShift + 1;
+    offset = index - (size_t(1) << high);
+}
+
+/* -----------------------------
+   initializePool()
+   Purpose: Link all nodes into the free list.
+   Input: None
+   Output: Free list initialized with all nodes
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::initializePool()
+{
+    size_t total = capacity();
+    size_t index = 0;
+    for (int s = 0; s < segmentCount; s++) {
+        size_t size = segmentSize(s);
+        for (size_t i = 0; i < size && index < total; i++) {
+            IndexT link = (index + 1 < total) ? IndexT(index + 1) : IndexT(NULL_INDEX);
+            if (concurrent)
+                freeLinks[s][i].store(link, memory_order_relaxed);
+            else
+                segments[s].next(i) = link; // Link to the next node
+            index++;
+        }
+    }
+    freePtr = 0; // Start of the free list
+    offList.set(0);
+    references.clear(); // No node is shared any more
+    freeStamped = false; // Payloads of all nodes are left as they were
+    for (size_t i = 0; i < generations.size(); i++) {
+        generations[i]++; // Every handle goes stale
+    }
+    if (concurrent) {
+        unsigned int tag = (unsigned int)(freeHead.load() >> 32);
+        freeHead.store(packHead(tag + 1, 0));
+
+        // Cached nodes are on the new free list too
+        lock_guard<mutex> guard(registryLock());
+        for (size_t m = 0; m < magazines.size(); m++) {
+            magazines[m]->count.store(0);
+        }
+    }
+}
+
+/* -----------------------------
+   Tagged head helpers
+   Purpose: Pack and unpack the concurrent free stack head.
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline unsigned long long BasicNodePool<T, IndexT, Layout>::packHead(unsigned int tag, IndexT index)
+{
+    return ((unsigned long long)tag << 32) | ((unsigned long long)index & HEAD_INDEX_MASK);
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline IndexT BasicNodePool<T, IndexT, Layout>::headIndex(unsigned long long head)
+{
+    return IndexT(head & HEAD_INDEX_MASK);
+}
+
+/* -----------------------------
+   freeLink()
+   Purpose: Access the free stack link of a node.
+   Input: index (IndexT)
+   Output: Reference to the atomic link
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline atomic<IndexT>& BasicNodePool<T, IndexT, Layout>::freeLink(IndexT index) const
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return freeLinks[segment][offset];
+}
+
+/* -----------------------------
+   firstFree() / nextFree()
+   Purpose: Walk the free list in either mode.
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline IndexT BasicNodePool<T, IndexT, Layout>::firstFree() const
+{
+    return concurrent ? headIndex(freeHead.load(memory_order_acquire)) : freePtr;
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline IndexT BasicNodePool<T, IndexT, Layout>::nextFree(IndexT index) const
+{
+    return concurrent ? freeLink(index).load(memory_order_relaxed) : next(index);
+}
+
+/* -----------------------------
+   popFree()
+   Purpose: Lock-free pop from the concurrent free stack.
+   Input: None
+   Output: Index of a free node, or NULL_INDEX if the stack is empty
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+IndexT BasicNodePool<T, IndexT, Layout>::popFree()
+{
+    unsigned long long head = freeHead.load(memory_order_acquire);
+    while (true) {
+        IndexT index = headIndex(head);
+        if (index == IndexT(NULL_INDEX)) {
+            return IndexT(NULL_INDEX);
+        }
+
+        // May read a stale link if index was popped meanwhile; the tag
+        // makes the compare-and-swap below fail in that case
+        IndexT following = freeLink(index).load(memory_order_relaxed);
+        unsigned long long replacement = packHead((unsigned int)(head >> 32) + 1, following);
+        if (freeHead.compare_exchange_weak(head, replacement,
+                                           memory_order_acquire, memory_order_acquire)) {
+            return index;
+        }
+    }
+}
+
+/* -----------------------------
+   pushFree()
+   Purpose: Lock-free push of a chain onto the concurrent free stack.
+   Input: first, last (IndexT) - chain linked through freeLink
+   Output: None
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::pushFree(IndexT first, IndexT last)
+{
+    unsigned long long head = freeHead.load(memory_order_relaxed);
+    while (true) {
+        freeLink(last).store(headIndex(head), memory_order_relaxed);
+        unsigned long long replacement = packHead((unsigned int)(head >> 32) + 1, first);
+        if (freeHead.compare_exchange_weak(head, replacement,
+                                           memory_order_release, memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+/* -----------------------------
+   popChain()
+   Purpose: Lock-free pop of a batch from the concurrent free stack.
+   Input: out (array of IndexT), count (size_t)
+   Output: Number of indices popped into out
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::popChain(IndexT* out, size_t count)
+{
+    unsigned long long head = freeHead.load(memory_order_acquire);
+    while (true) {
+        IndexT index = headIndex(head);
+        if (index == IndexT(NULL_INDEX)) {
+            return 0;
+        }
+
+        // Walk up to count nodes; as in popFree() the links may be stale,
+        // in which case the tag check rejects the whole batch
+        size_t taken = 0;
+        IndexT following = index;
+        while (taken < count && following != IndexT(NULL_INDEX)) {
+            out[taken++] = following;
+            following = freeLink(following).load(memory_order_relaxed);
+        }
+        unsigned long long replacement = packHead((unsigned int)(head >> 32) + 1, following);
+        if (freeHead.compare_exchange_weak(head, replacement,
+                                           memory_order_acquire, memory_order_acquire)) {
+            return taken;
+        }
+    }
+}
+
+/* -----------------------------
+   registryLock()
+   Purpose: Lock shared by the pools and thread racks of one pool type.
+   Input: None
+   Output: Reference to the mutex
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+mutex& BasicNodePool<T, IndexT, Layout>::registryLock()
+{
+    static mutex lock;
+    return lock;
+}
+
+template <typename T, typename IndexT, typename Layout>
+thread_local typename BasicNodePool<T, IndexT, Layout>::MagazineRack BasicNodePool<T, IndexT, Layout>::rack;
+
+/* -----------------------------
+   MagazineRack Destructor
+   Purpose: Flush a finished thread's magazines back to their pools.
+   Input: None
+   Output: Magazines freed, cached nodes on the shared free lists
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+BasicNodePool<T, IndexT, Layout>::MagazineRack::~MagazineRack()
+{
+    lock_guard<mutex> guard(registryLock());
+    for (size_t m = 0; m < magazines.size(); m++) {
+        Magazine* magazine = magazines[m];
+        BasicNodePool* pool = magazine->owner.load();
+        if (pool != 0) {
+            pool->spillMagazine(magazine, magazine->count.load(memory_order_relaxed));
+            vector<Magazine*>& registered = pool->magazines;
+            for (size_t r = 0; r < registered.size(); r++) {
+                if (registered[r] == magazine) {
+                    registered[r] = registered.back();
+                    registered.pop_back();
+                    break;
+                }
+            }
+        }
+        delete magazine;
+    }
+}
+
+/* -----------------------------
+   localMagazine()
+   Purpose: Find or create the calling thread's magazine for this pool.
+   Input: None
+   Output: Pointer to the magazine
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+typename BasicNodePool<T, IndexT, Layout>::Magazine* BasicNodePool<T, IndexT, Layout>::localMagazine()
+{
+    vector<Magazine*>& mine = rack.magazines;
+    for (size_t m = 0; m < mine.size(); m++) {
+        BasicNodePool* owner = mine[m]->owner.load(memory_order_acquire);
+        if (owner == this) {
+            if (m != 0) {
+                swap(mine[0], mine[m]); // Keep the busiest pool first
+            }
+            return mine[0];
+        }
+        if (owner == 0) {
+            delete mine[m]; // Its pool was destroyed
+            mine[m] = mine.back();
+            mine.pop_back();
+            m--;
+        }
+    }
+
+    Magazine* magazine = new Magazine;
+    magazine->owner.store(this);
+    magazine->slots.resize(magazineCapacity);
+    magazine->count.store(0);
+    {
+        lock_guard<mutex> guard(registryLock());
+        magazines.push_back(magazine);
+    }
+    mine.push_back(magazine);
+    swap(mine[0], mine.back());
+    return magazine;
+}
+
+/* -----------------------------
+   refillMagazine()
+   Purpose: Move half a magazine of free nodes into an empty magazine.
+   Input: magazine (pointer to Magazine)
+   Output: Number of nodes now cached, 0 if the pool is full
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::refillMagazine(Magazine* magazine)
+{
+    size_t batch = (magazine->slots.size() + 1) / 2;
+    while (true) {
+        size_t taken = popChain(&magazine->slots[0], batch);
+        if (taken > 0) {
+            countOut(taken);
+            magazine->count.store(taken, memory_order_relaxed);
+            return taken;
+        }
+
+        // Stack empty: grow unless another thread refilled it first
+        lock_guard<mutex> guard(growLock);
+        if (firstFree() == IndexT(NULL_INDEX) && !addSegment()) {
+            return 0;
+        }
+    }
+}
+
+/* -----------------------------
+   spillMagazine()
+   Purpose: Push the top cached nodes back as one chain.
+   Input: magazine (pointer to Magazine), count (size_t)
+   Output: None
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::spillMagazine(Magazine* magazine, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    size_t top = magazine->count.load(memory_order_relaxed);
+    const IndexT* slots = &magazine->slots[top - count];
+    for (size_t i = 0; i + 1 < count; i++) {
+        freeLink(slots[i]).store(slots[i + 1], memory_order_relaxed);
+    }
+    pushFree(slots[0], slots[count - 1]);
+    magazine->count.store(top - count, memory_order_relaxed);
+    countIn(count);
+}
+
+/* -----------------------------
+   setMagazineSize() / magazineSize()
+   Purpose: Configure the per-thread caches.
+   Input: size (size_t) - indices per magazine, 0 disables them
+   Output: Every magazine flushed and resized
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::setMagazineSize(size_t size)
+{
+    lock_guard<mutex> guard(registryLock());
+    for (size_t m = 0; m < magazines.size(); m++) {
+        spillMagazine(magazines[m], magazines[m]->count.load(memory_order_relaxed));
+        magazines[m]->slots.resize(size);
+    }
+    magazineCapacity = size;
+}
+
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::magazineSize() const
+{
+    return magazineCapacity;
+}
+
+/* -----------------------------
+   flushMagazine()
+   Purpose: Return the calling thread's cached nodes.
+   Input: None
+   Output: The thread's magazine for this pool is empty
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::flushMagazine()
+{
+    vector<Magazine*>& mine = rack.magazines;
+    for (size_t m = 0; m < mine.size(); m++) {
+        if (mine[m]->owner.load(memory_order_acquire) == this) {
+            spillMagazine(mine[m], mine[m]->count.load(memory_order_relaxed));
+            return;
+        }
+    }
+}
+
+/* -----------------------------
+   countOut() / countIn()
+   Purpose: Keep the count of nodes off the free list.
+   Input: count (size_t)
+   Output: None
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline void BasicNodePool<T, IndexT, Layout>::countOut(size_t count)
+{
+    offList.add(count, concurrent);
+    STATS_ONLY(highWater.raiseTo(offList.get(), concurrent);)
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline void BasicNodePool<T, IndexT, Layout>::countIn(size_t count)
+{
+    offList.subtract(count, concurrent);
+}
+
+/* -----------------------------
+   stats()
+   Purpose: Snapshot of the pool's counters.
+   Input: None
+   Output: PoolStats
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+PoolStats BasicNodePool<T, IndexT, Layout>::stats() const
+{
+    PoolStats result;
+    result.inUse = length();
+    result.capacity = capacity();
+    result.highWater = 0;
+    result.acquires = 0;
+    result.releases = 0;
+    result.failures = 0;
+#ifdef NODEPOOL_STATS
+    result.highWater = size_t(highWater.get());
+    result.acquires = acquires.get();
+    result.releases = releases.get();
+    result.failures = failures.get();
+#endif
+    return result;
+}
+
+/* -----------------------------
+   resetStats()
+   Purpose: Restart the collected counters.
+   Input: None
+   Output: Counters zeroed, high-water mark at the current level
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::resetStats()
+{
+#ifdef NODEPOOL_STATS
+    highWater.set(offList.get());
+    acquires.set(0);
+    releases.set(0);
+    failures.set(0);
+#endif
+}
+
+/* -----------------------------
+   isConcurrent()
+   Purpose: Report the free list mode.
+   Input: None
+   Output: true for POOL_CONCURRENT
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::isConcurrent() const
+{
+    return concurrent;
+}
+
+/* -----------------------------
+   isFull()
+   Purpose: Check if the node pool has no free nodes available.
+   Input: None
+   Output: true if the pool is full and cannot grow, false otherwise
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::isFull() const
+{
+    return firstFree() == IndexT(NULL_INDEX) && capacity() >= maxNodes;
+}
+
+/* -----------------------------
+   grow()
+   Purpose: Add one segment and link its nodes into the free list.
+   Input: None
+   Output: true if the pool grew, false if it is at its limit
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::grow()
+{
+    if (concurrent) {
+        lock_guard<mutex> guard(growLock);
+        return addSegment();
+    }
+    return addSegment();
+}
+
+/* -----------------------------
+   addSegment()
+   Purpose: Allocate the next segment and free its nodes.
+   Input: None
+   Output: true if the pool grew, false if it is at its limit
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::addSegment()
+{
+    size_t total = capacity();
+    if (total >= maxNodes || segmentCount == MAX_SEGMENTS) {
+        return false;
+    }
+
+    size_t size = segmentSize(segmentCount);
+    if (size > maxNodes - total) {
+        size = maxNodes - total; // Last segment is cut at the limit
+    }
+
+    int s = segmentCount;
+    if (!allocateSegment(s)) {
+        return false;
+    }
+    freeLinks[s] = concurrent ? new atomic<IndexT>[segmentSize(s)] : 0;
+
+    size_t first = total;
+    for (size_t i = 0; i < size - 1; i++) {
+        if (concurrent)
+            freeLinks[s][i].store(IndexT(first + i + 1), memory_order_relaxed);
+        else
+            segments[s].next(i) = IndexT(first + i + 1);
+    }
+
+    // Publish the segment before any of its indices can be handed out
+    freeStamped = false; // The new nodes hold no filler yet
+    segmentCount++;
+    myCapacity.store(total + size, memory_order_release);
+
+    // New nodes go in front of the free list
+    IndexT last = IndexT(first + size - 1);
+    if (concurrent) {
+        pushFree(IndexT(first), last);
+    }
+    else {
+        segments[s].next(size - 1) = freePtr;
+        freePtr = IndexT(first);
+    }
+    return true;
+}
+
+/* -----------------------------
+   acquireNode()
+   Purpose: Acquire a free node from the pool.
+   Input: None
+   Output: Index of acquired node, or NULL_INDEX if none available
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+IndexT BasicNodePool<T, IndexT, Layout>::acquireNode()
+{
+    if (concurrent && magazineCapacity > 0) {
+        Magazine* magazine = localMagazine();
+        size_t count = magazine->count.load(memory_order_relaxed);
+        if (count == 0 && (count = refillMagazine(magazine)) == 0) {
+            STATS_ONLY(failures.add(1, true);)
+            cerr << "Error: No free nodes available." << endl;
+            return IndexT(NULL_INDEX);
+        }
+        STATS_ONLY(acquires.add(1, true);)
+        magazine->count.store(count - 1, memory_order_relaxed);
+        return magazine->slots[count - 1];
+    }
+
+    if (concurrent) {
+        while (true) {
+            IndexT index = popFree();
+            if (index != IndexT(NULL_INDEX)) {
+                countOut(1);
+                STATS_ONLY(acquires.add(1, true);)
+                return index;
+            }
+
+            // Stack empty: grow unless another thread refilled it first
+            lock_guard<mutex> guard(growLock);
+            if (firstFree() == IndexT(NULL_INDEX) && !addSegment()) {
+                STATS_ONLY(failures.add(1, true);)
+                cerr << "Error: No free nodes available." << endl;
+                return IndexT(NULL_INDEX);
+            }
+        }
+    }
+
+    if (freePtr == IndexT(NULL_INDEX) && !grow()) {
+        STATS_ONLY(failures.add(1, false);)
+        cerr << "Error: No free nodes available." << endl;
+        return IndexT(NULL_INDEX);
+    }
+
+    IndexT index = freePtr;             // Take the first free node
+    freePtr = next(freePtr);           // Advance freePtr to next free node
+    countOut(1);
+    STATS_ONLY(acquires.add(1, false);)
+    return index;
+}
+
+/* -----------------------------
+   releaseNode()
+   Purpose: Release a node back into the free list.
+   Input: index (IndexT) - node index to release
+   Output: None
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::releaseNode(IndexT index)
+{
+    retire(index); // Handles to the node go stale
+    stampFree(index);
+    if (concurrent && magazineCapacity > 0) {
+        Magazine* magazine = localMagazine();
+        size_t count = magazine->count.load(memory_order_relaxed);
+        if (count == magazine->slots.size()) {
+            spillMagazine(magazine, (count + 1) / 2); // Full: return half
+            count = magazine->count.load(memory_order_relaxed);
+        }
+        magazine->slots[count] = index;
+        magazine->count.store(count + 1, memory_order_relaxed);
+        STATS_ONLY(releases.add(1, true);)
+        return;
+    }
+
+    if (concurrent) {
+        pushFree(index, index);
+        countIn(1);
+        STATS_ONLY(releases.add(1, true);)
+        return;
+    }
+
+    next(index) = freePtr;         // Link this node to current free list
+    freePtr = index;               // Update freePtr to point to this node
+    countIn(1);
+    STATS_ONLY(releases.add(1, false);)
+}
+
+/* -----------------------------
+   acquireNodes()
+   Purpose: Acquire a chain of nodes in one call.
+   Input: count (size_t), last (IndexT, by reference)
+   Output: First node of the chain, or NULL_INDEX if not enough nodes
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+IndexT BasicNodePool<T, IndexT, Layout>::acquireNodes(size_t count, IndexT& last)
+{
+    last = IndexT(NULL_INDEX);
+    if (count == 0) {
+        return IndexT(NULL_INDEX);
+    }
+
+    if (concurrent) {
+        // Pop the whole batch, usually with a single compare-and-swap
+        vector<IndexT> taken(count);
+        size_t have = 0;
+        while (have < count) {
+            size_t got = popChain(&taken[have], count - have);
+            if (got > 0) {
+                have += got;
+                continue;
+            }
+            lock_guard<mutex> guard(growLock);
+            if (firstFree() == IndexT(NULL_INDEX) && !addSegment()) {
+                break;
+            }
+        }
+        if (have < count) {
+            // Put back what was taken; the request fails as a whole
+            if (have > 0) {
+                for (size_t i = 0; i + 1 < have; i++) {
+                    freeLink(taken[i]).store(taken[i + 1], memory_order_relaxed);
+                }
+                pushFree(taken[0], taken[have - 1]);
+            }
+            STATS_ONLY(failures.add(1, true);)
+            cerr << "Error: No free nodes available." << endl;
+            return IndexT(NULL_INDEX);
+        }
+        countOut(count);
+        STATS_ONLY(acquires.add(count, true);)
+        for (size_t i = 0; i + 1 < count; i++) {
+            next(taken[i]) = taken[i + 1];
+        }
+        next(taken[count - 1]) = IndexT(NULL_INDEX);
+        last = taken[count - 1];
+        return taken[0];
+    }
+
+    // Find the node ending the chain, growing while the free list is short
+    size_t have = 0;
+    IndexT current = IndexT(NULL_INDEX);
+    while (true) {
+        IndexT following = (have == 0) ? freePtr : next(current);
+        if (following == IndexT(NULL_INDEX)) {
+            // New segments go in front of the free list: count again
+            size_t before = capacity();
+            size_t needed = count - have;
+            while (capacity() - before < needed) {
+                if (!addSegment()) {
+                    STATS_ONLY(failures.add(1, false);)
+                    cerr << "Error: No free nodes available." << endl;
+                    return IndexT(NULL_INDEX);
+                }
+            }
+            have = 0;
+            continue;
+        }
+        current = following;
+        if (++have == count) {
+            break;
+        }
+    }
+
+    IndexT first = freePtr;
+    freePtr = next(current);
+    next(current) = IndexT(NULL_INDEX);
+    last = current;
+    countOut(count);
+    STATS_ONLY(acquires.add(count, false);)
+    return first;
+}
+
+/* -----------------------------
+   releaseChain()
+   Purpose: Return a chain of nodes to the free list in one splice.
+   Input: first, last (IndexT), count (size_t)
+   Output: None
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::releaseChain(IndexT first, IndexT last, size_t count)
+{
+    if (first == IndexT(NULL_INDEX) || count == 0) {
+        return;
+    }
+    countIn(count);
+    STATS_ONLY(releases.add(count, concurrent);)
+    if (!generations.empty() || freeStamped) {
+        IndexT current = first;
+        for (size_t i = 0; i < count; i++) {
+            retire(current);
+            stampFree(current);
+            current = next(current);
+        }
+    }
+
+    if (concurrent) {
+        // Free links are a separate array: copy the chain's links over
+        IndexT current = first;
+        for (size_t i = 1; i < count; i++) {
+            IndexT following = next(current);
+            freeLink(current).store(following, memory_order_relaxed);
+            current = following;
+        }
+        pushFree(first, last);
+        return;
+    }
+
+    next(last) = freePtr;  // Splice the whole chain in front
+    freePtr = first;
+}
+
+/* -----------------------------
+   compact()
+   Purpose: Renumber a chain so it runs through ascending indices.
+   Input: head, tail (IndexT, updated), count (size_t)
+   Output: true if the chain was moved
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::compact(IndexT& head, IndexT& tail, size_t count)
+{
+    if (concurrent) {
+        cerr << "Error: Cannot compact a concurrent pool." << endl;
+        return false;
+    }
+    if (count == 0) {
+        return sortFreeList();
+    }
+
+    enum { OTHER = 0, FREE = 1, CHAIN = 2, PLACED = 3 };
+    size_t total = capacity();
+    vector<char> role(total, OTHER);
+    vector<IndexT> at; // at[k]: where the k-th node of the chain is now
+    at.reserve(count);
+    for (IndexT i = head; i != IndexT(NULL_INDEX) && at.size() <= count; i = next(i)) {
+        at.push_back(i);
+    }
+    if (at.size() != count) {
+        cerr << "Error: Chain does not hold " << count << " nodes." << endl;
+        return false;
+    }
+
+    vector<IndexT> occupant(total, IndexT(NULL_INDEX)); // Chain position held by a slot
+    for (size_t k = 0; k < count; k++) {
+        role[at[k]] = CHAIN;
+        occupant[at[k]] = IndexT(k);
+    }
+    for (IndexT i = freePtr; i != IndexT(NULL_INDEX); i = next(i)) {
+        role[i] = FREE;
+    }
+
+    // The k-th usable slot from the bottom receives the k-th node
+    size_t k = 0;
+    for (size_t slot = 0; slot < total && k < count; slot++) {
+        if (role[slot] == OTHER) {
+            continue;
+        }
+        IndexT from = at[k];
+        if (size_t(from) != slot) {
+            swap(data(from), data(IndexT(slot)));
+            retire(from); // Both payloads changed nodes
+            retire(IndexT(slot));
+            IndexT displaced = occupant[slot];
+            occupant[from] = displaced;
+            if (displaced != IndexT(NULL_INDEX)) {
+                at[displaced] = from;
+            }
+            at[k] = IndexT(slot);
+        }
+        occupant[slot] = IndexT(k);
+        role[slot] = PLACED;
+        k++;
+    }
+
+    for (k = 0; k + 1 < count; k++) {
+        next(at[k]) = at[k + 1];
+    }
+    next(at[count - 1]) = IndexT(NULL_INDEX);
+    if constexpr (Segment::BACK_LINKS) {
+        prev(at[0]) = IndexT(NULL_INDEX);
+        for (k = 1; k < count; k++) {
+            prev(at[k]) = at[k - 1];
+        }
+    }
+    head = at[0];
+    tail = at[count - 1];
+
+    // Everything the chain could have used but did not is free
+    for (size_t slot = 0; slot < total; slot++) {
+        role[slot] = (role[slot] == FREE || role[slot] == CHAIN);
+    }
+    relinkFree(role);
+    return true;
+}
+
+/* -----------------------------
+   sortFreeList()
+   Purpose: Put the free list in ascending index order.
+   Input: None
+   Output: true unless the pool is concurrent
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::sortFreeList()
+{
+    if (concurrent) {
+        cerr << "Error: Cannot sort the free list of a concurrent pool." << endl;
+        return false;
+    }
+    vector<char> isFree(capacity(), 0);
+    for (IndexT i = freePtr; i != IndexT(NULL_INDEX); i = next(i)) {
+        isFree[i] = 1;
+    }
+    relinkFree(isFree);
+    return true;
+}
+
+/* -----------------------------
+   relinkFree()
+   Purpose: Link the marked nodes into an ascending free list.
+   Input: isFree (one mark per node)
+   Output: freePtr and the links of free nodes rewritten
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::relinkFree(const vector<char>& isFree)
+{
+    IndexT first = IndexT(NULL_INDEX);
+    for (size_t slot = isFree.size(); slot-- > 0;) {
+        if (isFree[slot]) {
+            next(IndexT(slot)) = first;
+            first = IndexT(slot);
+        }
+    }
+    freePtr = first;
+}
+
+/* -----------------------------
+   getNode()
+   Purpose: Access a node by index.
+   Input: index (IndexT)
+   Output: Reference to node at given index
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+typename BasicNodePool<T, IndexT, Layout>::NodeRef BasicNodePool<T, IndexT, Layout>::getNode(IndexT index)
+{
+    if (size_t(index) >= capacity()) {
+        cerr << "Error: Invalid node index " << index << endl;
+        index = 0; // Returns first node
+    }
+    NodeRef node = { data(index), next(index) };
+    return node;
+}
+
+template <typename T, typename IndexT, typename Layout>
+typename BasicNodePool<T, IndexT, Layout>::ConstNodeRef BasicNodePool<T, IndexT, Layout>::getNode(IndexT index) const
+{
+    if (size_t(index) >= capacity()) {
+        cerr << "Error: Invalid node index " << index << endl;
+        index = 0; // Returns first node
+    }
+    ConstNodeRef node = { data(index), next(index) };
+    return node;
+}
+
+/* -----------------------------
+   loadNext() / publishNext()
+   Purpose: Read or write a link atomically for concurrent readers.
+   Input: index (IndexT), link (IndexT) for publishNext
+   Output: The link (loadNext)
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline IndexT BasicNodePool<T, IndexT, Layout>::loadNext(IndexT index) const
+{
+    static_assert(sizeof(atomic<IndexT>) == sizeof(IndexT) && atomic<IndexT>::is_always_lock_free,
+                  "Links must be accessible as lock-free atomics");
+    return reinterpret_cast<const atomic<IndexT>&>(next(index)).load(memory_order_acquire);
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline void BasicNodePool<T, IndexT, Layout>::publishNext(IndexT index, IndexT link)
+{
+    reinterpret_cast<atomic<IndexT>&>(next(index)).store(link, memory_order_release);
+}
+
+/* -----------------------------
+   next()
+   Purpose: Access the link of a node without its data.
+   Input: index (IndexT)
+   Output: Reference to the node's next index
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline IndexT& BasicNodePool<T, IndexT, Layout>::next(IndexT index)
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return segments[segment].next(offset);
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline const IndexT& BasicNodePool<T, IndexT, Layout>::next(IndexT index) const
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return segments[segment].next(offset);
+}
+
+/* -----------------------------
+   prev()
+   Purpose: Access the back link of a node.
+   Input: index (IndexT)
+   Output: Reference to the node's prev index
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline IndexT& BasicNodePool<T, IndexT, Layout>::prev(IndexT index)
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return segments[segment].prev(offset);
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline const IndexT& BasicNodePool<T, IndexT, Layout>::prev(IndexT index) const
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return segments[segment].prev(offset);
+}
+
+/* -----------------------------
+   data()
+   Purpose: Access the data of a node.
+   Input: index (IndexT)
+   Output: Reference to the node's data
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline T& BasicNodePool<T, IndexT, Layout>::data(IndexT index)
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return segments[segment].data(offset);
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline const T& BasicNodePool<T, IndexT, Layout>::data(IndexT index) const
+{
+    int segment;
+    size_t offset;
+    locate(size_t(index), segment, offset);
+    return segments[segment].data(offset);
+}
+
+/* -----------------------------
+   emplace()
+   Purpose: Construct a node's data in place.
+   Input: index (IndexT), constructor arguments
+   Output: data(index) rebuilt from args
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+template <typename... Args>
+void BasicNodePool<T, IndexT, Layout>::emplace(IndexT index, Args&&... args)
+{
+    T* slot = &data(index);
+    slot->~T();
+    try {
+        new (slot) T(std::forward<Args>(args)...);
+    }
+    catch (...) {
+        new (slot) T(); // Every slot must hold a live T
+        throw;
+    }
+}
+
+/* -----------------------------
+   findPayload()
+   Purpose: Scan the payloads for a value in index order.
+   Input: value (T), from (IndexT)
+   Output: First matching node index at or after from, or NULL_INDEX
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+IndexT BasicNodePool<T, IndexT, Layout>::findPayload(const T& value, IndexT from) const
+{
+    size_t total = capacity();
+    size_t start = size_t(from);
+    while (start < total) {
+        int segment;
+        size_t offset;
+        locate(start, segment, offset);
+        size_t size = min(segmentSize(segment), total - (start - offset)); // maxCapacity may cut the last one
+        size_t found;
+        if constexpr (Segment::DENSE_PAYLOAD) {
+            found = offset + PayloadScan<T>::find(segments[segment].payloadArray() + offset,
+                                                  size - offset, value);
+        }
+        else {
+            for (found = offset; found < size; found++) {
+                if (segments[segment].data(found) == value) {
+                    break;
+                }
+            }
+        }
+        if (found < size) {
+            return IndexT(start - offset + found);
+        }
+        start += size - offset; // First node of the next segment
+    }
+    return IndexT(NULL_INDEX);
+}
+
+/* -----------------------------
+   findInChain()
+   Purpose: Position of the first node of a chain equal to value.
+   Input: head (IndexT), value (T)
+   Output: Position, or -1 if not found
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+long BasicNodePool<T, IndexT, Layout>::findInChain(IndexT head, const T& value) const
+{
+    if constexpr (PayloadScan<T>::AVAILABLE) {
+        if (isScanFiller(value)) {
+            // Free nodes hold this value: compare along the chain instead
+            long position = 0;
+            for (IndexT i = head; i != IndexT(NULL_INDEX); i = next(i)) {
+                if (memcmp(&data(i), &value, sizeof(T)) == 0) {
+                    return position;
+                }
+                position++;
+            }
+            return -1;
+        }
+        if (!freeStamped) {
+            freeStamped = true; // Released nodes are stamped from now on
+            for (IndexT i = firstFree(); i != IndexT(NULL_INDEX); i = nextFree(i)) {
+                stampFree(i);
+            }
+        }
+    }
+
+    IndexT match = findPayload(value);
+    if (match == IndexT(NULL_INDEX) || head == IndexT(NULL_INDEX)) {
+        return -1; // Decided by the scan alone
+    }
+
+    // Mark every matching node, then walk the links to the first mark
+    if (chainMarks.size() < (capacity() + 63) / 64) {
+        chainMarks.resize((capacity() + 63) / 64, 0);
+    }
+    chainHits.clear();
+    for (; match != IndexT(NULL_INDEX) && size_t(match) < capacity();
+         match = findPayload(value, IndexT(match + 1))) {
+        chainMarks[size_t(match) / 64] |= 1ULL << (size_t(match) % 64);
+        chainHits.push_back(match);
+        if (size_t(match) + 1 >= capacity()) {
+            break;
+        }
+    }
+    long position = 0;
+    IndexT i = head;
+    for (; i != IndexT(NULL_INDEX); i = next(i)) {
+        if (chainMarks[size_t(i) / 64] & (1ULL << (size_t(i) % 64))) {
+            break;
+        }
+        position++;
+    }
+    for (size_t h = 0; h < chainHits.size(); h++) {
+        chainMarks[size_t(chainHits[h]) / 64] = 0; // Ready for the next search
+    }
+    return (i == IndexT(NULL_INDEX)) ? -1 : position;
+}
+
+/* -----------------------------
+   isScanFiller() / stampFree()
+   Purpose: Keep released payloads out of findInChain's scan.
+   Input: value (T) / index (IndexT) of a node being freed
+   Output: true if every bit of value is set / the node holds such a
+           value once scans are in use
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::isScanFiller(const T& value)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (size_t b = 0; b < sizeof(T); b++) {
+        if (bytes[b] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename IndexT, typename Layout>
+inline void BasicNodePool<T, IndexT, Layout>::stampFree(IndexT index) const
+{
+    if constexpr (PayloadScan<T>::AVAILABLE) {
+        if (freeStamped) {
+            int segment;
+            size_t offset;
+            locate(size_t(index), segment, offset);
+            memset(static_cast<void*>(&segments[segment].data(offset)), 0xFF, sizeof(T));
+        }
+    }
+}
+
+/* -----------------------------
+   addReference()
+   Purpose: Record one more reference to a shared node.
+   Input: index (IndexT)
+   Output: Reference count raised
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::addReference(IndexT index)
+{
+    if (size_t(index) >= references.size()) {
+        references.resize(capacity(), 0);
+    }
+    references[index]++;
+}
+
+/* -----------------------------
+   dropReference()
+   Purpose: Give up one reference to a node.
+   Input: index (IndexT)
+   Output: true if others still refer to it
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::dropReference(IndexT index)
+{
+    if (size_t(index) < references.size() && references[index] > 0) {
+        references[index]--;
+        return true;
+    }
+    return false; // Sole reference: the caller may release the node
+}
+
+/* -----------------------------
+   isShared()
+   Purpose: Check whether a node has more than one reference.
+   Input: index (IndexT)
+   Output: true if shared
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+bool BasicNodePool<T, IndexT, Layout>::isShared(IndexT index) const
+{
+    return size_t(index) < references.size() && references[index] > 0;
+}
+
+/* -----------------------------
+   handleOf()
+   Purpose: Make a handle to a node.
+   Input: index (IndexT)
+   Output: Handle stamped with the node's generation
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+typename BasicNodePool<T, IndexT, Layout>::Handle BasicNodePool<T, IndexT, Layout>::handleOf(IndexT index)
+{
+    if (size_t(index) >= generations.size()) {
+        generations.resize(capacity(), 0); // First handle, or the pool grew
+    }
+    return Handle(index, generations[index]);
+}
+
+/* -----------------------------
+   isValid()
+   Purpose: Check that a handle's node has not been released since.
+   Input: handle (Handle)
+   Output: true if the generations match
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline bool BasicNodePool<T, IndexT, Layout>::isValid(Handle handle) const
+{
+#ifndef NDEBUG
+    if (size_t(handle.index) >= generations.size()) {
+        return false; // Null, or not made by handleOf
+    }
+#endif
+    return generations[handle.index] == handle.generation;
+}
+
+/* -----------------------------
+   retire()
+   Purpose: Make every handle to a node stale.
+   Input: index (IndexT)
+   Output: Generation advanced
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+inline void BasicNodePool<T, IndexT, Layout>::retire(IndexT index)
+{
+    if (size_t(index) < generations.size()) {
+        generations[index]++;
+    }
+}
+
+/* -----------------------------
+   displayFreeList()
+   Purpose: Display indices of nodes in free list.
+   Input: None
+   Output: Prints free list to console
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::displayFreeList() const
+{
+    cout << "Free List: ";
+    IndexT current = firstFree();
+    while (current != IndexT(NULL_INDEX)) {
+        cout << current << " ";
+        current = nextFree(current);
+    }
+    cout << endl;
+
+    if (concurrent) {
+        // Nodes cached by threads are free as well
+        lock_guard<mutex> guard(registryLock());
+        for (size_t m = 0; m < magazines.size(); m++) {
+            size_t count = magazines[m]->count.load(memory_order_relaxed);
+            if (count == 0) {
+                continue;
+            }
+            cout << "Magazine " << m << ": ";
+            for (size_t i = 0; i < count; i++) {
+                cout << magazines[m]->slots[i] << " ";
+            }
+            cout << endl;
+        }
+    }
+}
+
+/* -----------------------------
+   list()
+   Purpose: Display contents of the entire node pool.
+   Input: None
+   Output: Prints data and next index of each node
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::list() const
+{
+    cout << "Node Pool Contents" << endl;
+    for (size_t i = 0; i < capacity(); i++) {
+        cout << "[" << i << "] "
+            << "Data: \"" << data(IndexT(i)) << "\", "
+            << "Next: " << next(IndexT(i)) << endl;
+    }
+}
+
+/* -----------------------------
+   clear()
+   Purpose: Reset the pool by reinitializing free list and clearing data.
+   Input: None
+   Output: NodePool reset to default state
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+void BasicNodePool<T, IndexT, Layout>::clear()
+{
+    initializePool();  // Re-link all nodes into free list
+    if constexpr (PayloadArena<T>::OWNED) {
+        payloadArena.reset(); // Every view is dropped at once
+        return;
+    }
+    for (int s = 0; s < segmentCount; s++) {
+        size_t size = segmentSize(s);
+        for (size_t i = 0; i < size; i++) {
+            segments[s].data(i) = T();  // Clear data (including unused tail)
+        }
+    }
+}
+
+/* -----------------------------
+   arena()
+   Purpose: Access the arena of the pool's payloads.
+   Input: None
+   Output: Reference to the arena
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+typename BasicNodePool<T, IndexT, Layout>::Arena& BasicNodePool<T, IndexT, Layout>::arena()
+{
+    return payloadArena;
+}
+
+template <typename T, typename IndexT, typename Layout>
+const typename BasicNodePool<T, IndexT, Layout>::Arena& BasicNodePool<T, IndexT, Layout>::arena() const
+{
+    return payloadArena;
+}
+
+/* -----------------------------
+   length()
+   Purpose: Return number of nodes currently in use in O(1).
+   Input: None
+   Output: Count of used nodes
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::length() const
+{
+    size_t used = size_t(offList.get()); // Kept by acquire and release
+
+    if (concurrent && magazineCapacity > 0) {
+        // Nodes cached in magazines are off the list but still free
+        lock_guard<mutex> guard(registryLock());
+        for (size_t m = 0; m < magazines.size(); m++) {
+            used -= magazines[m]->count.load(memory_order_relaxed);
+        }
+    }
+
+    return used;
+}
+
+/* -----------------------------
+   capacity()
+   Purpose: Return number of nodes allocated in all segments.
+   Input: None
+   Output: Total node count
+   ----------------------------- */
+template <typename T, typename IndexT, typename Layout>
+size_t BasicNodePool<T, IndexT, Layout>::capacity() const
+{
+    return myCapacity.load(memory_order_acquire);
+}